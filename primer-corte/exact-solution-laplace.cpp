@@ -1,18 +1,50 @@
+// Compilar: g++ -std=c++17 -O3 -march=native -fno-math-errno -fopenmp-simd exact-solution-laplace.cpp
 #include <iostream>
 #include <fstream>
 #include <cmath>
 #include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 
+// Formato binario de malla: la cabecera seguida de nx*ny doubles, con el
+// indice de y variando mas rapido (mismo orden que el archivo de texto).
+struct CabeceraMalla{
+    char magia[4];
+    int32_t nx, ny;
+    double xmin, xmax, ymin, ymax;
+};
+const char MAGIA_MALLA[4] = {'M', 'A', 'L', 'L'};
+
 double potencial(double x, double y, double R, double V0);
+void evaluarMalla(double R, double V0, const CabeceraMalla &cab, vector<double> &V);
+bool escribirBinario(const string &nombre, const CabeceraMalla &cab, const vector<double> &V);
+bool leerSolucion(const string &nombre, CabeceraMalla &cab, vector<double> &V);
+bool leerMatriz(const string &nombre, CabeceraMalla &cab, vector<double> &V);
+int solicitarModo();
 void solicitarDatos(double &R, double &V0, int &nPuntos);
+void solicitarDatosComparacion(double &R, double &V0, string &archivo, int &formato, CabeceraMalla &extension);
 void generarDatos(double R, double V0, int nPuntos);
+bool compararSolucion(const string &archivo, int formato, const CabeceraMalla &extension,
+                      double R, double V0, const string &archivoError);
 void generarGrafica();
 
 int main(){
     double R, V0;
     int nPuntos;
+    if(solicitarModo() == 2){
+        string archivo;
+        int formato;
+        CabeceraMalla extension;
+        memset(&extension, 0, sizeof(extension));
+        solicitarDatosComparacion(R, V0, archivo, formato, extension);
+        return compararSolucion(archivo, formato, extension, R, V0, "error-laplace.bin") ? 0 : 1;
+    }
     solicitarDatos(R, V0, nPuntos);
     generarDatos(R, V0, nPuntos);
     generarGrafica();
@@ -27,6 +59,142 @@ double potencial(double x, double y, double R, double V0){
         return V0 * (R / r);
 }
 
+// Version por lotes de potencial(): como V0*R/sqrt(max(r^2, R^2)) vale V0
+// dentro del circulo, la rama desaparece y el lazo sobre y se vectoriza.
+void evaluarMalla(double R, double V0, const CabeceraMalla &cab, vector<double> &V){
+    const int nx = cab.nx, ny = cab.ny;
+    double dx = nx > 1 ? (cab.xmax - cab.xmin) / (nx - 1) : 0.0;
+    double dy = ny > 1 ? (cab.ymax - cab.ymin) / (ny - 1) : 0.0;
+    double R2 = R * R, VR = V0 * R;
+    V.resize(static_cast<size_t>(nx) * ny);
+    for(int i = 0; i < nx; ++i){
+        double x = cab.xmin + i * dx;
+        double x2 = x * x;
+        double* fila = &V[static_cast<size_t>(i) * ny];
+        #pragma omp simd
+        for(int j = 0; j < ny; ++j){
+            double y = cab.ymin + j * dy;
+            fila[j] = VR / sqrt(max(x2 + y * y, R2));
+        }
+    }
+}
+
+bool escribirBinario(const string &nombre, const CabeceraMalla &cab, const vector<double> &V){
+    ofstream archivo(nombre, ios::binary);
+    if(!archivo)
+        return false;
+    archivo.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    archivo.write(reinterpret_cast<const char*>(V.data()), V.size() * sizeof(double));
+    return static_cast<bool>(archivo);
+}
+
+// Acepta el formato binario de malla o texto 'x y V' por lineas (el que
+// escribe generarDatos); en texto la malla se deduce del cambio de x.
+bool leerSolucion(const string &nombre, CabeceraMalla &cab, vector<double> &V){
+    ifstream archivo(nombre, ios::binary);
+    if(!archivo)
+        return false;
+    string contenido((istreambuf_iterator<char>(archivo)), istreambuf_iterator<char>());
+    if(contenido.size() >= sizeof(cab) && memcmp(contenido.data(), MAGIA_MALLA, 4) == 0){
+        memcpy(&cab, contenido.data(), sizeof(cab));
+        size_t n = static_cast<size_t>(cab.nx) * cab.ny;
+        if(cab.nx <= 0 || cab.ny <= 0 || contenido.size() != sizeof(cab) + n * sizeof(double))
+            return false;
+        V.resize(n);
+        memcpy(V.data(), contenido.data() + sizeof(cab), n * sizeof(double));
+        return true;
+    }
+    vector<double> xs, ys;
+    V.clear();
+    const char* p = contenido.c_str();
+    char* fin;
+    while(true){
+        double x = strtod(p, &fin);
+        if(fin == p) break;
+        // Una linea cortada tras 'x' o 'x y' invalida el archivo
+        p = fin;
+        double y = strtod(p, &fin);
+        if(fin == p) return false;
+        p = fin;
+        double v = strtod(p, &fin);
+        if(fin == p) return false;
+        xs.push_back(x);
+        ys.push_back(y);
+        V.push_back(v);
+        p = fin;
+    }
+    if(V.empty())
+        return false;
+    size_t ny = 1;
+    while(ny < xs.size() && xs[ny] == xs[0])
+        ++ny;
+    if(V.size() % ny != 0)
+        return false;
+    memcpy(cab.magia, MAGIA_MALLA, 4);
+    cab.nx = V.size() / ny;
+    cab.ny = ny;
+    cab.xmin = xs.front();
+    cab.xmax = xs.back();
+    cab.ymin = ys.front();
+    cab.ymax = ys[ny - 1];
+    return true;
+}
+
+// Lee la matriz que escriben GenerarDatos/EscribirSolucion en FD_laplaceEquation: una
+// fila de la malla por linea, la fila j en y = ymin + j*dy y la columna i en
+// x = xmin + i*dx. El archivo no trae coordenadas, asi que la extension llega en
+// cab (xmin, xmax, ymin, ymax) y aqui se completan nx y ny.
+bool leerMatriz(const string &nombre, CabeceraMalla &cab, vector<double> &V){
+    ifstream archivo(nombre);
+    if(!archivo)
+        return false;
+    vector<double> filas;
+    size_t columnas = 0, nFilas = 0;
+    string linea;
+    while(getline(archivo, linea)){
+        const char* p = linea.c_str();
+        char* fin;
+        size_t enFila = 0;
+        while(true){
+            double v = strtod(p, &fin);
+            if(fin == p) break;
+            filas.push_back(v);
+            ++enFila;
+            p = fin;
+        }
+        if(strspn(p, " \t\r") != strlen(p))
+            return false;   // algo que no es un numero
+        if(enFila == 0)
+            continue;
+        if(columnas == 0)
+            columnas = enFila;
+        else if(enFila != columnas)
+            return false;
+        ++nFilas;
+    }
+    if(nFilas < 2 || columnas < 2)
+        return false;
+
+    // Al orden de la cabecera: el indice de y (la fila) varia mas rapido
+    memcpy(cab.magia, MAGIA_MALLA, 4);
+    cab.nx = static_cast<int32_t>(columnas);
+    cab.ny = static_cast<int32_t>(nFilas);
+    V.resize(filas.size());
+    for(size_t j = 0; j < nFilas; ++j)
+        for(size_t i = 0; i < columnas; ++i)
+            V[i * nFilas + j] = filas[j * columnas + i];
+    return true;
+}
+
+int solicitarModo(){
+    int modo;
+    do{
+        cout << "Modo (1: generar solucion exacta, 2: comparar con una solucion numerica): ";
+        cin >> modo;
+    } while(modo != 1 && modo != 2);
+    return modo;
+}
+
 void solicitarDatos(double &R, double &V0, int &nPuntos){
     do{
         cout << "Ingrese el radio del círculo (R > 0): ";
@@ -40,26 +208,96 @@ void solicitarDatos(double &R, double &V0, int &nPuntos){
     } while(nPuntos < 2);
 }
 
+void solicitarDatosComparacion(double &R, double &V0, string &archivo, int &formato, CabeceraMalla &extension){
+    do{
+        cout << "Ingrese el radio del círculo (R > 0): ";
+        cin >> R;
+    } while(R <= 0);
+    cout << "Ingrese el valor del potencial en el contorno (V0): ";
+    cin >> V0;
+    cout << "Ingrese el archivo de la solucion numerica: ";
+    cin >> archivo;
+    do{
+        cout << "Formato (1: binario de malla o texto 'x y V', 2: matriz de FD_laplaceEquation): ";
+        cin >> formato;
+    } while(formato != 1 && formato != 2);
+    if(formato == 2){
+        do{
+            cout << "Ingrese la extension de la malla (xmin xmax ymin ymax): ";
+            cin >> extension.xmin >> extension.xmax >> extension.ymin >> extension.ymax;
+        } while(!(extension.xmin < extension.xmax && extension.ymin < extension.ymax));
+    }
+}
+
+// El texto se arma en un buffer por fila y se escribe en bloque (sin endl);
+// la misma malla se guarda en binario para las comparaciones.
 void generarDatos(double R, double V0, int nPuntos){
-    ofstream archivo("potencial-laplace.dat");
+    ofstream archivo("potencial-laplace.dat", ios::binary);
     if(!archivo){
         cerr << "Error al abrir el archivo de salida." << endl;
         return;
     }
-    double xmin = -2.0 * R, xmax = 2.0 * R, ymin = -2.0 * R, ymax = 2.0 * R;
-    double dx = (xmax - xmin) / (nPuntos - 1);
-    double dy = (ymax - ymin) / (nPuntos - 1);
+    CabeceraMalla cab;
+    memset(&cab, 0, sizeof(cab));   // el relleno tras ny tambien se escribe al archivo
+    memcpy(cab.magia, MAGIA_MALLA, 4);
+    cab.nx = cab.ny = nPuntos;
+    cab.xmin = cab.ymin = -2.0 * R;
+    cab.xmax = cab.ymax = 2.0 * R;
+    vector<double> V;
+    evaluarMalla(R, V0, cab, V);
+
+    double dx = (cab.xmax - cab.xmin) / (nPuntos - 1);
+    double dy = (cab.ymax - cab.ymin) / (nPuntos - 1);
+    vector<char> buffer(static_cast<size_t>(nPuntos) * 64 + 2);
     for(int i = 0; i < nPuntos; ++i){
-        double x = xmin + i * dx;
+        double x = cab.xmin + i * dx;
+        size_t usado = 0;
         for(int j = 0; j < nPuntos; ++j){
-            double y = ymin + j * dy;
-            double V = potencial(x, y, R, V0);
-            archivo << x << " " << y << " " << V << endl;
+            double y = cab.ymin + j * dy;
+            usado += snprintf(&buffer[usado], buffer.size() - usado, "%g %g %g\n",
+                              x, y, V[static_cast<size_t>(i) * nPuntos + j]);
         }
-        archivo << endl;
+        buffer[usado++] = '\n';
+        archivo.write(buffer.data(), usado);
     }
     archivo.close();
     cout << "Datos generados en el archivo 'potencial-laplace.dat'." << endl;
+    if(escribirBinario("potencial-laplace.bin", cab, V))
+        cout << "Malla binaria guardada en 'potencial-laplace.bin'." << endl;
+    else
+        cerr << "Error al escribir 'potencial-laplace.bin'." << endl;
+}
+
+// Evalua la solucion exacta sobre la malla del archivo numerico y reporta
+// las normas L2 (media cuadratica) e infinito del error; el mapa de error
+// numerico - exacto se guarda en binario.
+bool compararSolucion(const string &archivo, int formato, const CabeceraMalla &extension,
+                      double R, double V0, const string &archivoError){
+    CabeceraMalla cab = extension;
+    vector<double> numerica, exacta;
+    bool leida = formato == 2 ? leerMatriz(archivo, cab, numerica) : leerSolucion(archivo, cab, numerica);
+    if(!leida){
+        cerr << "Error al leer la solucion numerica '" << archivo << "'." << endl;
+        return false;
+    }
+    evaluarMalla(R, V0, cab, exacta);
+
+    double suma2 = 0.0, maximo = 0.0;
+    for(size_t k = 0; k < exacta.size(); ++k){
+        double e = numerica[k] - exacta[k];
+        numerica[k] = e;
+        suma2 += e * e;
+        maximo = max(maximo, fabs(e));
+    }
+    double l2 = sqrt(suma2 / exacta.size());
+    cout << "Malla " << cab.nx << " x " << cab.ny << ": error L2 = " << l2
+         << ", error Linf = " << maximo << endl;
+    if(!escribirBinario(archivoError, cab, numerica)){
+        cerr << "Error al escribir '" << archivoError << "'." << endl;
+        return false;
+    }
+    cout << "Mapa de error guardado en '" << archivoError << "'." << endl;
+    return true;
 }
 
 void generarGrafica(){
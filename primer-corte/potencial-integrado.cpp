@@ -1,96 +1,619 @@
+// Compilar: g++ -std=c++17 -O3 -march=native -fno-math-errno -fopenmp-simd -pthread potencial-integrado.cpp
+// Verificar la tolerancia de la cuadratura adaptativa: ./a.out --verificar
+// Con -DPOTENCIAL_INTEGRADO_BIBLIOTECA se omite main y el archivo se enlaza como
+// biblioteca (lo usa el modulo de Python de primer_parcial/python).
 #include <iostream>
 #include <fstream>
 #include <cmath>
 #include <string>
 #include <cstdlib>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <complex>
+#include <sstream>
+
+#include "potencial-integrado.h"
 
 using namespace std;
 
 const double PI = 3.141592653589793;
 const int N = 100;
+const int BLOQUE = 8;   // puntos (x, y) que el nucleo SIMD evalua a la vez
+const int TESELA = 64;  // lado de las teselas de la malla repartidas entre hilos
+const int N_MIN = 8;       // nodos iniciales del trapecio adaptativo
+const int N_MAX = 4096;    // nodos de la tabla adaptativa (potencia de 2)
+const int HOJA = 32;       // cargas maximas por hoja del arbol multipolar
+const double THETA = 0.5;  // criterio de apertura: radio / distancia < THETA
+const int P_MAX = 40;      // orden maximo de la expansion multipolar
+
+// Nodos del anillo precalculados: evita cos/sin en cada punto de la malla
+struct NodosAnillo{
+    vector<double> x, y;
+    double peso;
+};
+
+struct Carga{
+    double x, y, q;
+};
 
-void solicitarDatos(double &R, double &lambda, int &malla);
-bool validarDatos(double R, double lambda, int malla);
-double trapecio(double x, double y, double R);
-void calcularPotencial(double R, double** potencial, int malla);
-void guardarDatos(double** potencial, double R, int malla);
+// Celda del quadtree: cargas[inicio, fin) y sus momentos multipolares
+// M(j, k) = c_j c_k sum q w^j conj(w)^k con w relativo al centro y j + k <= p.
+struct CeldaArbol{
+    double cx, cy, radio;
+    int inicio, fin;
+    int hijos[4];
+    vector<complex<double>> momentos;
+};
+
+struct ArbolMultipolar{
+    vector<Carga> cargas;
+    vector<CeldaArbol> celdas;
+    vector<double> coef;   // c_k = binomial(2k, k) / 4^k
+    int p;
+};
+
+void solicitarDatos(double &R, double &lambda, int &malla, double &tol, int &metodo, string &archivo);
+bool validarDatos(double R, double lambda, int malla, double tol, int metodo);
+NodosAnillo crearNodos(double R, int n);
+double trapecio(const NodosAnillo &nodos, double x, double y);
+void nucleoPotencial(const NodosAnillo &nodos, double x, const double* y, double* V);
+double trapecioPeriodico(const NodosAnillo &tabla, double x, double y, double R, double tol, int n);
+double trapecioSingular(const NodosAnillo &tabla, double x, double y, double R, double tol);
+double trapecioAdaptativo(const NodosAnillo &tabla, double x, double y, double R, double tol);
+double potencialAnilloExacto(double x, double y, double R);
+bool verificarTolerancia();
+void recorrerTeselas(int malla, const function<void(int, int, int)> &fila);
+vector<Segmento> leerSegmentos(const string &archivo);
+vector<Carga> discretizarSegmentos(const vector<Segmento> &segmentos, double h);
+int construirCelda(ArbolMultipolar &arbol, int inicio, int fin, double cx, double cy, double lado, int nivel);
+ArbolMultipolar construirArbol(vector<Carga> cargas, double tol);
+double evaluarArbol(const ArbolMultipolar &arbol, double x, double y);
+void guardarDatos(const vector<double> &potencial, double R, int malla);
 void GenerarGrafica();
 
-int main(){
-    double R, lambda;
-    int malla;
-    solicitarDatos(R, lambda, malla);
-    if(!validarDatos(R, lambda, malla)){
+#ifndef POTENCIAL_INTEGRADO_BIBLIOTECA
+int main(int argc, char *argv[]){
+    if(argc > 1 && string(argv[1]) == "--verificar")
+        return verificarTolerancia() ? 0 : 1;
+    double R, lambda, tol;
+    int malla, metodo;
+    string archivo;
+    solicitarDatos(R, lambda, malla, tol, metodo, archivo);
+    if(!validarDatos(R, lambda, malla, tol, metodo)){
         cout<<"Datos invalidos. Terminando el programa."<<endl;
         return 1;
     }
-    double** potencial = new double*[malla];
-    for(int i = 0; i < malla; i++){
-        potencial[i] = new double[malla];
+    vector<double> potencial;
+    if(metodo == 2){
+        vector<Segmento> segmentos = (archivo == "-") ? segmentosAnillo(R, N) : leerSegmentos(archivo);
+        if(segmentos.empty()){
+            cout << "No se pudieron leer segmentos de '" << archivo << "'. Terminando el programa." << endl;
+            return 1;
+        }
+        calcularPotencialArbol(segmentos, R, potencial, malla, tol > 0.0 ? tol : 1e-6);
+    }else{
+        calcularPotencial(R, potencial, malla, tol);
     }
-    calcularPotencial(R, potencial, malla);
     guardarDatos(potencial, R, malla);
     GenerarGrafica();
-    for(int i = 0; i < malla; i++){
-        delete [] potencial[i];
-    }
-    delete [] potencial;
     return 0;
 }
+#endif
 
-void solicitarDatos(double &R, double &lambda, int &malla){
+void solicitarDatos(double &R, double &lambda, int &malla, double &tol, int &metodo, string &archivo){
     cout << "Ingrese el radio del circulo (R): ";
     cin >> R;
     cout << "Ingrese la densidad lineal de carga (lambda): ";
     cin >> lambda;
     cout << "Ingrese el numero de puntos en la malla: ";
     cin >> malla;
+    cout << "Ingrese la tolerancia relativa de la integral (0 para trapecio fijo de " << N << " puntos): ";
+    cin >> tol;
+    cout << "Ingrese el metodo (1: cuadratura del anillo, 2: arbol multipolar sobre segmentos): ";
+    cin >> metodo;
+    if(metodo == 2){
+        cout << "Ingrese el archivo de segmentos 'x0 y0 x1 y1 lambda' ('-' para el anillo): ";
+        cin >> archivo;
+    }
 }
 
-bool validarDatos(double R, double lambda, int malla){
+bool validarDatos(double R, double lambda, int malla, double tol, int metodo){
     if(R <= 0.0 || lambda <= 0.0 || malla <= 0){
         cout << "Error: El radio, la densidad de carga y el numero de puntos deben ser positivos." << endl;
         return false;
     }
+    if(tol < 0.0){
+        cout << "Error: La tolerancia no puede ser negativa." << endl;
+        return false;
+    }
+    if(metodo != 1 && metodo != 2){
+        cout << "Error: El metodo debe ser 1 o 2." << endl;
+        return false;
+    }
     return true;
 }
 
-double trapecio(double x, double y, double R){
-    double h = (2 * PI) / N;
+NodosAnillo crearNodos(double R, int n){
+    NodosAnillo nodos;
+    double h = (2 * PI) / n;
+    nodos.x.resize(n);
+    nodos.y.resize(n);
+    for(int k = 0; k < n; k++){
+        nodos.x[k] = R * cos(k * h);
+        nodos.y[k] = R * sin(k * h);
+    }
+    nodos.peso = R * h;
+    return nodos;
+}
+
+// Trapecio periodico: los extremos theta = 0 y theta = 2*PI son el mismo nodo,
+// asi que la regla se reduce a la suma de los n nodos con peso R*h.
+double trapecio(const NodosAnillo &nodos, double x, double y){
+    const int n = nodos.x.size();
     double suma = 0.0;
-    for(int i = 0; i <= N; i++){
-        double theta = i * h;
-        double r = sqrt(pow(x - R * cos(theta), 2) + pow(y - R * sin(theta), 2));
-        double f = 1.0 / r;
-        if(i == 0 || i == N)
-            suma += f;
+    for(int k = 0; k < n; k++){
+        double dx = x - nodos.x[k];
+        double dy = y - nodos.y[k];
+        suma += 1.0 / sqrt(dx * dx + dy * dy);
+    }
+    return nodos.peso * suma;
+}
+
+// Evalua BLOQUE puntos de una misma fila (x fijo) contra todos los nodos.
+// El lazo interno sobre los puntos no tiene dependencias y se vectoriza.
+void nucleoPotencial(const NodosAnillo &nodos, double x, const double* y, double* V){
+    const int n = nodos.x.size();
+    const double* nx = nodos.x.data();
+    const double* ny = nodos.y.data();
+    double acum[BLOQUE] = {0.0};
+    for(int k = 0; k < n; k++){
+        double dx = x - nx[k];
+        double dx2 = dx * dx;
+        double yk = ny[k];
+        #pragma omp simd
+        for(int p = 0; p < BLOQUE; p++){
+            double dy = y[p] - yk;
+            acum[p] += 1.0 / sqrt(dx2 + dy * dy);
+        }
+    }
+    for(int p = 0; p < BLOQUE; p++){
+        V[p] = nodos.peso * acum[p];
+    }
+}
+
+// Lejos del anillo el integrando es periodico y analitico: el error relativo
+// del trapecio decae como q^n con q = min(rho/R, R/rho). Se duplica n
+// reutilizando la suma anterior (los nodos nuevos son los puntos medios),
+// empezando en n nodos (potencia de 2 entre N_MIN y N_MAX). La diferencia
+// entre dos niveles sola no basta: el error oscila con n (aliasing) y dos
+// niveles pueden coincidir por casualidad. Se pide ademas que q^n <= tol.
+double trapecioPeriodico(const NodosAnillo &tabla, double x, double y, double R, double tol, int n){
+    double rho = sqrt(x * x + y * y);
+    double nMinimo = log(1.0 / tol) / fabs(log(rho / R));   // q^n <= tol
+    int paso = N_MAX / n;
+    double suma = 0.0;
+    for(int k = 0; k < N_MAX; k += paso){
+        double dx = x - tabla.x[k], dy = y - tabla.y[k];
+        suma += 1.0 / sqrt(dx * dx + dy * dy);
+    }
+    double I = tabla.peso * paso * suma;
+    while(paso > 1){
+        for(int k = paso / 2; k < N_MAX; k += paso){
+            double dx = x - tabla.x[k], dy = y - tabla.y[k];
+            suma += 1.0 / sqrt(dx * dx + dy * dy);
+        }
+        n *= 2;
+        paso /= 2;
+        double Inuevo = tabla.peso * paso * suma;
+        double dif = fabs(Inuevo - I) / fabs(Inuevo);
+        if(dif <= tol && n >= nMinimo)
+            return Inuevo;
+        I = Inuevo;
+    }
+    return I;
+}
+
+// Cerca del anillo, en el angulo u = theta - phi medido desde el punto,
+// |r - r'|^2 = a + b sin^2(u/2) con a = (rho - R)^2 y b = 4 rho R. Se resta
+// s(u) = 1/sqrt(a + b u^2/4), cuya integral en [-PI, PI] es analitica y
+// contiene la singularidad logaritmica, y el resto acotado se integra con
+// trapecio + Romberg (u = 0 y u = +-PI son nodos de todos los niveles).
+// El resto tiene un detalle de ancho w = sqrt(a/b) en u = 0 que aporta un
+// error relativo del orden de w^2 mientras el paso no lo resuelve, y dos
+// niveles pueden coincidir por casualidad. Se piden dos diferencias seguidas
+// por debajo de tol y, ademas, un paso menor que 4w o w^2 <= tol. Pasada la
+// tabla de N_MAX nodos sin(v) se calcula directamente. A menos de ~1e-6 del
+// anillo el redondeo limita el error relativo a ~1e-11.
+double trapecioSingular(const NodosAnillo &tabla, double x, double y, double R, double tol){
+    double rho = sqrt(x * x + y * y);
+    double a = (rho - R) * (rho - R), b = 4.0 * rho * R;
+    if(a == 0.0)
+        return HUGE_VAL;
+    double Is = 4.0 / sqrt(b) * asinh(PI * sqrt(b) / (2.0 * sqrt(a)));
+    double ancho = sqrt(a / b);
+
+    // resto(u) = 1/s1 - 1/s2 escrito sin cancelacion para u pequeno
+    auto resto = [&](int k, int n){
+        int m = (2 * k < n) ? k : k - n;              // u = 2*PI*m/n en [-PI, PI)
+        double v = PI * m / n;                         // v = u/2
+        double av = fabs(v), d, sv;                    // sv = |sin(v)|
+        if(2 * n <= N_MAX)
+            sv = tabla.y[(m >= 0 ? m : -m) * (N_MAX / (2 * n))] / R;
         else
-            suma += 2 * f;
+            sv = sin(av);
+        if(av < 0.1){
+            double v2 = av * av;
+            d = av * v2 * (1.0 / 6 - v2 * (1.0 / 120 - v2 * (1.0 / 5040 - v2 / 362880)));
+        }else{
+            d = av - sv;
+        }
+        double s1 = sqrt(a + b * sv * sv), s2 = sqrt(a + b * v * v);
+        return b * d * (av + sv) / (s1 * s2 * (s1 + s2));
+    };
+
+    const int niveles = 18;   // hasta N_MIN * 2^17 nodos
+    double romb[niveles], anterior[niveles];
+    int n = N_MIN, nivel = 0;
+    double suma = 0.0;
+    for(int k = 0; k < n; k++)
+        suma += resto(k, n);
+    anterior[0] = 2.0 * PI / n * suma;
+    double I = R * (Is + anterior[0]);
+    bool difAnteriorBajoTol = false;
+    while(nivel + 1 < niveles){
+        for(int k = 1; k < 2 * n; k += 2)
+            suma += resto(k, 2 * n);
+        n *= 2;
+        nivel++;
+        romb[0] = 2.0 * PI / n * suma;
+        double factor = 1.0;
+        for(int m = 1; m <= nivel; m++){
+            factor *= 4.0;
+            romb[m] = romb[m - 1] + (romb[m - 1] - anterior[m - 1]) / (factor - 1.0);
+        }
+        double Inuevo = R * (Is + romb[nivel]);
+        copy(romb, romb + nivel + 1, anterior);
+        bool difBajoTol = fabs(Inuevo - I) <= tol * fabs(Inuevo);
+        bool resuelto = 2.0 * PI / n < 4.0 * ancho || ancho * ancho <= tol;
+        if(difBajoTol && difAnteriorBajoTol && resuelto)
+            return Inuevo;
+        difAnteriorBajoTol = difBajoTol;
+        I = Inuevo;
+    }
+    return I;
+}
+
+// Elige el metodo segun el numero de nodos que necesitaria el trapecio
+// periodico: n ~ ln(1/tol) / |ln(rho/R)|. Mientras quepa en la tabla con un
+// nivel de margen es mas barato que la resta de la singularidad.
+double trapecioAdaptativo(const NodosAnillo &tabla, double x, double y, double R, double tol){
+    double rho = sqrt(x * x + y * y);
+    double alfa = fabs(log(rho / R));
+    double nEstimado = log(1.0 / tol) / alfa;
+    if(nEstimado < N_MAX / 2){
+        int n = N_MIN;
+        while(4 * n < nEstimado)
+            n *= 2;
+        return trapecioPeriodico(tabla, x, y, R, tol, n);
+    }
+    return trapecioSingular(tabla, x, y, R, tol);
+}
+
+// Referencia cerrada: integral de R dtheta / |r - r'| = 4 R K(k) / (rho + R)
+// con k' = |rho - R| / (rho + R). K se calcula con la media aritmetico-
+// geometrica, K = PI / (2 AGM(1, k')), que usa k' directamente y no pierde
+// precision cerca del anillo (1 - k se cancelaria).
+double potencialAnilloExacto(double x, double y, double R){
+    double rho = sqrt(x * x + y * y);
+    double a = 1.0, g = fabs(rho - R) / (rho + R);
+    for(int i = 0; i < 40 && a != g; i++){
+        double siguiente = 0.5 * (a + g);
+        g = sqrt(a * g);
+        a = siguiente;
+    }
+    return 2 * PI * R / ((rho + R) * a);
+}
+
+// Compara la cuadratura adaptativa con la referencia cerrada en puntos dentro
+// y fuera del anillo, cada vez mas cerca de el, para varias tolerancias. Un
+// criterio de parada mal calibrado hace fallar algun punto.
+bool verificarTolerancia(){
+    const double R = 1.0;
+    NodosAnillo tabla = crearNodos(R, N_MAX);
+    tabla.peso = R * (2 * PI) / N_MAX;
+    const double tolerancias[] = {1e-4, 1e-6, 1e-8, 1e-10};
+    const double distancias[] = {0.5, 0.2, 0.05, 1e-2, 2e-3, 1e-3, 1e-4, 1e-5};
+    const double angulos[] = {0.0, 0.2, 1.1, 2.9};
+    bool correcto = true;
+    for(double tol : tolerancias){
+        double peor = 0.0;
+        for(double d : distancias)
+            for(int signo = -1; signo <= 1; signo += 2)
+                for(double angulo : angulos){
+                    double rho = R * (1.0 + signo * d);
+                    double x = rho * cos(angulo), y = rho * sin(angulo);
+                    double exacto = potencialAnilloExacto(x, y, R);
+                    double error = fabs(trapecioAdaptativo(tabla, x, y, R, tol) - exacto) / exacto;
+                    peor = max(peor, error / tol);
+                }
+        bool bien = peor <= 1.0;
+        correcto = correcto && bien;
+        cout << "tol = " << tol << ": error maximo / tol = " << peor << (bien ? "" : "  FALLA") << endl;
     }
-    return R * h * suma / 2.0;
+    return correcto;
 }
 
-void calcularPotencial(double R, double** potencial, int malla){
+// La malla se guarda contigua (potencial[i*malla + j]) y se divide en teselas
+// TESELA x TESELA que los hilos toman de un contador atomico; fila(i, j0, j1)
+// calcula el tramo [j0, j1) de la fila i.
+void recorrerTeselas(int malla, const function<void(int, int, int)> &fila){
+    int teselas = (malla + TESELA - 1) / TESELA;
+    int total = teselas * teselas;
+    atomic<int> siguiente(0);
+
+    auto trabajador = [&](){
+        int t;
+        while((t = siguiente++) < total){
+            int i0 = (t / teselas) * TESELA, i1 = min(i0 + TESELA, malla);
+            int j0 = (t % teselas) * TESELA, j1 = min(j0 + TESELA, malla);
+            for(int i = i0; i < i1; i++)
+                fila(i, j0, j1);
+        }
+    };
+
+    int nHilos = max(1u, thread::hardware_concurrency());
+    vector<thread> hilos;
+    for(int h = 1; h < nHilos; h++)
+        hilos.emplace_back(trabajador);
+    trabajador();
+    for(auto &hilo : hilos)
+        hilo.join();
+}
+
+// tol <= 0 usa el trapecio fijo de N nodos con el nucleo SIMD; tol > 0 usa
+// la cuadratura adaptativa punto a punto.
+void calcularPotencial(double R, vector<double> &potencial, int malla, double tol){
+    potencial.assign(static_cast<size_t>(malla) * malla, 0.0);
     double paso = (4 * R) / (malla - 1);
-    for(int i = 0; i < malla; i++){
-        for(int j = 0; j < malla; j++){
+
+    if(tol > 0.0){
+        NodosAnillo tabla = crearNodos(R, N_MAX);
+        tabla.peso = R * (2 * PI) / N_MAX;
+        recorrerTeselas(malla, [&](int i, int j0, int j1){
             double x = -2 * R + i * paso;
-            double y = -2 * R + j * paso;
-            potencial[i][j] = trapecio(x, y, R);
+            double* fila = &potencial[static_cast<size_t>(i) * malla];
+            for(int j = j0; j < j1; j++)
+                fila[j] = trapecioAdaptativo(tabla, x, -2 * R + j * paso, R, tol);
+        });
+        return;
+    }
+
+    NodosAnillo nodos = crearNodos(R, N);
+    recorrerTeselas(malla, [&](int i, int j0, int j1){
+        double y[BLOQUE], V[BLOQUE];
+        double x = -2 * R + i * paso;
+        double* fila = &potencial[static_cast<size_t>(i) * malla];
+        int j = j0;
+        for(; j + BLOQUE <= j1; j += BLOQUE){
+            for(int p = 0; p < BLOQUE; p++)
+                y[p] = -2 * R + (j + p) * paso;
+            nucleoPotencial(nodos, x, y, V);
+            copy(V, V + BLOQUE, fila + j);
+        }
+        for(; j < j1; j++){
+            fila[j] = trapecio(nodos, x, -2 * R + j * paso);
+        }
+    });
+}
+
+// Poligono de n cuerdas inscrito en el anillo, con densidad unitaria como
+// la integral de trapecio.
+vector<Segmento> segmentosAnillo(double R, int n){
+    vector<Segmento> segmentos(n);
+    double h = (2 * PI) / n;
+    for(int k = 0; k < n; k++){
+        segmentos[k] = {R * cos(k * h), R * sin(k * h),
+                        R * cos((k + 1) * h), R * sin((k + 1) * h), 1.0};
+    }
+    return segmentos;
+}
+
+vector<Segmento> leerSegmentos(const string &archivo){
+    vector<Segmento> segmentos;
+    ifstream entrada(archivo);
+    string linea;
+    while(getline(entrada, linea)){
+        if(linea.empty() || linea[0] == '#')
+            continue;
+        istringstream ss(linea);
+        Segmento s;
+        if(ss >> s.x0 >> s.y0 >> s.x1 >> s.y1 >> s.lambda)
+            segmentos.push_back(s);
+    }
+    return segmentos;
+}
+
+// Cada segmento se parte en tramos de longitud <= h y cada tramo se integra
+// con Gauss-Legendre de 2 puntos, que se convierten en cargas puntuales.
+vector<Carga> discretizarSegmentos(const vector<Segmento> &segmentos, double h){
+    vector<Carga> cargas;
+    const double g = 0.5 / sqrt(3.0);
+    for(const Segmento &s : segmentos){
+        double dx = s.x1 - s.x0, dy = s.y1 - s.y0;
+        double largo = sqrt(dx * dx + dy * dy);
+        int tramos = max(1, static_cast<int>(ceil(largo / h)));
+        double q = 0.5 * s.lambda * largo / tramos;
+        for(int t = 0; t < tramos; t++){
+            double u1 = (t + 0.5 - g) / tramos, u2 = (t + 0.5 + g) / tramos;
+            cargas.push_back({s.x0 + u1 * dx, s.y0 + u1 * dy, q});
+            cargas.push_back({s.x0 + u2 * dx, s.y0 + u2 * dy, q});
+        }
+    }
+    return cargas;
+}
+
+// Subdivide recursivamente la caja de centro (cx, cy) y lado 'lado' en
+// cuadrantes hasta que queden HOJA cargas o menos, y calcula los momentos.
+int construirCelda(ArbolMultipolar &arbol, int inicio, int fin, double cx, double cy, double lado, int nivel){
+    int id = arbol.celdas.size();
+    arbol.celdas.push_back(CeldaArbol());
+    Carga* c = arbol.cargas.data();
+
+    double mx = 0.0, my = 0.0, qabs = 0.0;
+    for(int i = inicio; i < fin; i++){
+        double w = fabs(c[i].q);
+        mx += w * c[i].x;
+        my += w * c[i].y;
+        qabs += w;
+    }
+    // El centro de la expansion es el centroide de |q| (o el de la caja)
+    double ex = qabs > 0.0 ? mx / qabs : cx, ey = qabs > 0.0 ? my / qabs : cy;
+    double radio = 0.0;
+    for(int i = inicio; i < fin; i++)
+        radio = max(radio, hypot(c[i].x - ex, c[i].y - ey));
+
+    int p = arbol.p;
+    vector<complex<double>> momentos((p + 1) * (p + 1), 0.0);
+    for(int i = inicio; i < fin; i++){
+        complex<double> w(c[i].x - ex, c[i].y - ey), wj = c[i].q;
+        for(int j = 0; j <= p; j++){
+            complex<double> wk = 1.0;
+            for(int k = 0; j + k <= p; k++){
+                momentos[j * (p + 1) + k] += wj * wk;
+                wk *= conj(w);
+            }
+            wj *= w;
+        }
+    }
+    for(int j = 0; j <= p; j++)
+        for(int k = 0; j + k <= p; k++)
+            momentos[j * (p + 1) + k] *= arbol.coef[j] * arbol.coef[k];
+
+    CeldaArbol &celda = arbol.celdas[id];
+    celda.cx = ex;
+    celda.cy = ey;
+    celda.radio = radio;
+    celda.inicio = inicio;
+    celda.fin = fin;
+    celda.momentos = move(momentos);
+    fill(celda.hijos, celda.hijos + 4, -1);
+
+    if(fin - inicio <= HOJA || nivel >= 30)
+        return id;
+
+    // Reparte las cargas en los cuatro cuadrantes de la caja
+    Carga* medio = partition(c + inicio, c + fin, [&](const Carga &a){ return a.y < cy; });
+    Carga* izq0 = partition(c + inicio, medio, [&](const Carga &a){ return a.x < cx; });
+    Carga* izq1 = partition(medio, c + fin, [&](const Carga &a){ return a.x < cx; });
+    int cortes[5] = {inicio, static_cast<int>(izq0 - c), static_cast<int>(medio - c),
+                     static_cast<int>(izq1 - c), fin};
+    double mitad = lado / 4;
+    double centros[4][2] = {{cx - mitad, cy - mitad}, {cx + mitad, cy - mitad},
+                            {cx - mitad, cy + mitad}, {cx + mitad, cy + mitad}};
+    for(int h = 0; h < 4; h++){
+        if(cortes[h + 1] > cortes[h]){
+            int hijo = construirCelda(arbol, cortes[h], cortes[h + 1], centros[h][0], centros[h][1], lado / 2, nivel + 1);
+            arbol.celdas[id].hijos[h] = hijo;
         }
     }
+    return id;
+}
+
+// El orden p se elige para que THETA^(p+1) quede por debajo de tol.
+ArbolMultipolar construirArbol(vector<Carga> cargas, double tol){
+    ArbolMultipolar arbol;
+    arbol.cargas = move(cargas);
+    arbol.p = min(P_MAX, max(2, static_cast<int>(ceil(log(tol) / log(THETA)))));
+    arbol.coef.resize(arbol.p + 1);
+    arbol.coef[0] = 1.0;
+    for(int k = 1; k <= arbol.p; k++)
+        arbol.coef[k] = arbol.coef[k - 1] * (2 * k - 1) / (2.0 * k);
+
+    if(arbol.cargas.empty())
+        return arbol;
+    double xmin = arbol.cargas[0].x, xmax = xmin, ymin = arbol.cargas[0].y, ymax = ymin;
+    for(const Carga &c : arbol.cargas){
+        xmin = min(xmin, c.x); xmax = max(xmax, c.x);
+        ymin = min(ymin, c.y); ymax = max(ymax, c.y);
+    }
+    double lado = max(xmax - xmin, ymax - ymin) * (1.0 + 1e-12) + 1e-300;
+    construirCelda(arbol, 0, arbol.cargas.size(), 0.5 * (xmin + xmax), 0.5 * (ymin + ymax), lado, 0);
+    return arbol;
+}
+
+// Recorre el arbol desde la raiz: las celdas bien separadas se evaluan con
+// 1/|z - w| = (1/|z|) sum c_j c_k (w/z)^j (conj(w)/conj(z))^k y el resto se
+// abre hasta llegar a las hojas, que se suman directamente.
+double evaluarArbol(const ArbolMultipolar &arbol, double x, double y){
+    if(arbol.celdas.empty())
+        return 0.0;
+    const int p = arbol.p;
+    complex<double> potencias[P_MAX + 1];
+    double V = 0.0;
+    int pila[128], tope = 0;
+    pila[tope++] = 0;
+    while(tope > 0){
+        const CeldaArbol &celda = arbol.celdas[pila[--tope]];
+        double dx = x - celda.cx, dy = y - celda.cy;
+        double d = sqrt(dx * dx + dy * dy);
+        if(celda.radio < THETA * d){
+            complex<double> zeta = 1.0 / complex<double>(dx, dy);
+            potencias[0] = 1.0;
+            for(int j = 1; j <= p; j++)
+                potencias[j] = potencias[j - 1] * zeta;
+            complex<double> suma = 0.0;
+            for(int j = 0; j <= p; j++){
+                complex<double> interna = 0.0;
+                for(int k = 0; j + k <= p; k++)
+                    interna += celda.momentos[j * (p + 1) + k] * conj(potencias[k]);
+                suma += potencias[j] * interna;
+            }
+            V += suma.real() / d;
+        }else if(celda.hijos[0] < 0 && celda.hijos[1] < 0 && celda.hijos[2] < 0 && celda.hijos[3] < 0){
+            for(int i = celda.inicio; i < celda.fin; i++){
+                double cx = x - arbol.cargas[i].x, cy = y - arbol.cargas[i].y;
+                V += arbol.cargas[i].q / sqrt(cx * cx + cy * cy);
+            }
+        }else{
+            for(int h = 0; h < 4; h++)
+                if(celda.hijos[h] >= 0)
+                    pila[tope++] = celda.hijos[h];
+        }
+    }
+    return V;
+}
+
+// Igual que calcularPotencial pero para una lista arbitraria de segmentos:
+// O((malla^2 + cargas) log(cargas)) en lugar de O(malla^2 * cargas).
+// tol solo fija el orden de la expansion (el error del campo lejano). El
+// campo cercano usa las cargas de discretizarSegmentos, con tramos del paso
+// de la malla: a una distancia del orden de ese paso el error de la
+// cuadratura de Gauss no depende de tol y puede ser mucho mayor.
+void calcularPotencialArbol(const vector<Segmento> &segmentos, double R, vector<double> &potencial, int malla, double tol){
+    potencial.assign(static_cast<size_t>(malla) * malla, 0.0);
+    double paso = (4 * R) / (malla - 1);
+    ArbolMultipolar arbol = construirArbol(discretizarSegmentos(segmentos, paso), tol);
+    recorrerTeselas(malla, [&](int i, int j0, int j1){
+        double x = -2 * R + i * paso;
+        double* fila = &potencial[static_cast<size_t>(i) * malla];
+        for(int j = j0; j < j1; j++)
+            fila[j] = evaluarArbol(arbol, x, -2 * R + j * paso);
+    });
 }
 
-void guardarDatos(double** potencial, double R, int malla){
+void guardarDatos(const vector<double> &potencial, double R, int malla){
     ofstream archivo("potencial.dat");
     double paso = (4 * R) / (malla - 1);
     for(int i = 0; i < malla; i++){
         for(int j = 0; j < malla; j++){
             double x = -2 * R + i * paso;
             double y = -2 * R + j * paso;
-            archivo << x << " " << y << " " << potencial[i][j] << endl;
+            archivo << x << " " << y << " " << potencial[static_cast<size_t>(i) * malla + j] << "\n";
         }
-        archivo << endl;
+        archivo << "\n";
     }
     archivo.close();
 }
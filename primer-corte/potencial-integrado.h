@@ -0,0 +1,18 @@
+// Interfaz de potencial-integrado.cpp compilado con -DPOTENCIAL_INTEGRADO_BIBLIOTECA.
+// La incluyen ese archivo y el modulo de Python de primer_parcial/python, de modo que
+// Segmento tiene una sola definicion.
+#ifndef POTENCIAL_INTEGRADO_H
+#define POTENCIAL_INTEGRADO_H
+
+#include <vector>
+
+// Segmento rectilineo con densidad lineal de carga uniforme
+struct Segmento{
+    double x0, y0, x1, y1, lambda;
+};
+
+void calcularPotencial(double R, std::vector<double> &potencial, int malla, double tol);
+std::vector<Segmento> segmentosAnillo(double R, int n);
+void calcularPotencialArbol(const std::vector<Segmento> &segmentos, double R, std::vector<double> &potencial, int malla, double tol);
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef CAPACITANCIA_H
+#define CAPACITANCIA_H
+
+#include <vector>
+#include <Eigen/Dense>
+#include "espacioTrabajo.h"
+#include "laplaceKernels.h"
+#include "transformadas.h"
+
+/**
+ * @file capacitancia.h
+ * @brief Solución directa del problema discreto de SolucionDF con una DST y una matriz de capacitancia.
+ *
+ * El sistema de 5 puntos sobre el rectángulo completo se resuelve en O(N^2 log N):
+ * DST-I en x por filas y, para cada modo, el sistema tridiagonal en y. Las celdas fijas
+ * de la escalera se imponen con cargas sigma en el conjunto Gamma de celdas fijas que
+ * tocan alguna celda libre: sigma resuelve C sigma = g - u0, con C = (A^{-1}) restringida
+ * a Gamma. El resultado es la solución exacta del sistema que SOR aproxima.
+ */
+
+/**
+ * @brief Solucionador directo para la malla nx x ny con la escalera de SolucionDF.
+ *
+ * La construcción depende solo de la geometría: arma y factoriza C (Cholesky), con costo
+ * O(|Gamma|^2 nx + |Gamma|^3). Cada resolución posterior cuesta dos resoluciones rápidas
+ * del rectángulo, así que el mismo objeto sirve para varias condiciones de frontera.
+ * No es seguro compartirlo entre hilos.
+ */
+class SolucionadorCapacitancia {
+public:
+    /**
+     * @brief Precalcula las tablas del rectángulo y factoriza la matriz de capacitancia.
+     *
+     * @param nx Número de divisiones en la dirección x de la malla.
+     * @param ny Número de divisiones en la dirección y de la malla.
+     */
+    SolucionadorCapacitancia(int nx, int ny);
+
+    /**
+     * @brief Resuelve el problema discreto sobre la malla.
+     *
+     * La malla debe traer escritas las fronteras del rectángulo y los valores de las celdas
+     * fijas de la escalera (como las deja AplicarFronteras); solo se sobrescriben las celdas libres.
+     *
+     * @param u Malla (ny + 1) x (nx + 1) con las fronteras y la escalera.
+     */
+    void resolver(VistaMalla& u);
+
+    /**
+     * @brief Número de celdas de Gamma (dimensión de la matriz de capacitancia).
+     */
+    int puntosCapacitancia() const { return static_cast<int>(gamma_j_.size()); }
+
+    /**
+     * @brief Dimensiones de la malla para la que se construyó.
+     */
+    int nx() const { return geometria_.nx; }
+    int ny() const { return geometria_.ny; }
+
+private:
+    /**
+     * @brief Aplica A^{-1} del rectángulo en el lugar sobre el arreglo interior f.
+     */
+    void resolverRectangulo(double* f);
+
+    bool fija(int j, int i) const;
+
+    GeometriaEscalera geometria_;
+    int columnas_;                  // nx - 1 celdas interiores por fila
+    PlanDST dst_;
+    std::vector<double> inverso_;   // 1 / (d_k + c'_{j-1}) de la eliminación de Thomas
+    std::vector<int> gamma_j_, gamma_i_;
+    Eigen::LLT<Eigen::MatrixXd> cholesky_;
+    std::vector<double> rectangulo_, cargas_;
+};
+
+/**
+ * @brief Escribe fronteras y escalera en la malla de un espacio de trabajo y la resuelve con un
+ *        solucionador ya factorizado (la opción 3 de SolucionDF sin rehacer la factorización).
+ *
+ * @param fronteraIzquierda Valor constante de la condición de frontera en el lado izquierdo.
+ * @param base Valor constante de la condición de frontera en la base.
+ * @param escalera Valor constante de la condición de frontera en la escalera saliente.
+ * @param directo Solucionador construido para la malla nx x ny.
+ * @param espacio Espacio de trabajo que conserva la malla entre llamadas.
+ * @return Vista de la solución, válida hasta la siguiente resolución con el mismo espacio.
+ */
+VistaMalla SolucionDirecta(double fronteraIzquierda, double base, double escalera,
+                           SolucionadorCapacitancia& directo, EspacioTrabajo& espacio);
+
+#endif // CAPACITANCIA_H
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include "espacioTrabajo.h"
 
 /**
  * @brief Solicita al usuario los parámetros necesarios para resolver la ecuación de Laplace.
@@ -14,7 +15,7 @@
  * @param ny Número de divisiones en la dirección y de la malla.
  * @param lambda Parámetro de sobrerrelajación para el método de Gauss-Seidel.
  * @param criterioConvergencia Porcentaje de error relativo para la convergencia.
- * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen).
+ * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen, 3 para la solución directa).
  * @param opcionGrafica Entero que indica la herramienta de graficación a usar (1 para Python, 2 para Gnuplot).
  */
 void IngresarDatos(double& fronteraIzquierda, double& base, double& escalera,
@@ -56,12 +57,33 @@ int VerificarDatos(double fronteraIzquierda, double base, double escalera,
  * @param nx Número de divisiones en la dirección x de la malla.
  * @param ny Número de divisiones en la dirección y de la malla.
  * @param lambda Parámetro de sobrerrelajación (0 < lambda <= 2).
- * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen).
+ * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen, 3 para la solución directa).
  * @return La matriz de la solución.
  */
 std::vector<std::vector<double>> SolucionDF(double fronteraIzquierda, double base, double escalera,
                                            int nx, int ny, double lambda, int opcionImplementacion);
 
+/**
+ * @brief Resuelve la ecuación de Laplace sobre la memoria de un espacio de trabajo.
+ *
+ * No reserva memoria cuando el espacio ya tiene el tamaño del problema, así que un
+ * barrido que reutiliza el mismo espacio no hace reservas en estado estacionario.
+ * La vista es válida hasta la siguiente resolución con el mismo espacio.
+ *
+ * @param fronteraIzquierda Valor constante de la condición de frontera en el lado izquierdo.
+ * @param base Valor constante de la condición de frontera en la base.
+ * @param escalera Valor constante de la condición de frontera en la escalera saliente.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param lambda Parámetro de sobrerrelajación (0 < lambda <= 2).
+ * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen, 3 para la solución directa).
+ * @param espacio Espacio de trabajo que conserva la malla entre llamadas.
+ * @return Vista de la solución (datos nulos si la opción no es válida).
+ */
+VistaMalla SolucionDF(double fronteraIzquierda, double base, double escalera,
+                      int nx, int ny, double lambda, int opcionImplementacion,
+                      EspacioTrabajo& espacio);
+
 /**
  * @brief Genera un archivo con los datos de la solución de la ecuación de Laplace.
  *
@@ -78,6 +100,22 @@ std::string GenerarDatos(const std::vector<std::vector<double>>& solucion,
                            int nx, int ny, double lambda,
                            double fronteraIzquierda, double base, double escalera);
 
+/**
+ * @brief Genera un archivo con los datos de una solución guardada en una vista de malla.
+ *
+ * @param solucion Vista de la malla con la solución.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param lambda Parámetro de sobrerrelajación utilizado.
+ * @param fronteraIzquierda Valor de la frontera izquierda.
+ * @param base Valor de la base.
+ * @param escalera Valor de la escalera saliente.
+ * @return El nombre del archivo generado.
+ */
+std::string GenerarDatos(const VistaMalla& solucion,
+                           int nx, int ny, double lambda,
+                           double fronteraIzquierda, double base, double escalera);
+
 /**
  * @brief Genera un gráfico de la solución de la ecuación de Laplace.
  *
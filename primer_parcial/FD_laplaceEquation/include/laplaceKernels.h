@@ -0,0 +1,187 @@
+#ifndef LAPLACE_KERNELS_H
+#define LAPLACE_KERNELS_H
+
+#include <cmath>
+#include <cstddef>
+#include <Eigen/Dense>
+
+/**
+ * @file laplaceKernels.h
+ * @brief Núcleo de sobrerrelajación (SOR) parametrizado por políticas de compilación.
+ *
+ * Las políticas son:
+ * - Almacenamiento: cómo se accede a u(j, i) (arreglo plano o mapa de Eigen).
+ * - Estencil: la aproximación del laplaciano (promedio de 5 puntos).
+ * - Geometría: las fronteras y el bloque de celdas fijas de la escalera en cada fila.
+ * - Omega: el parámetro de sobrerrelajación, dinámico o conocido en compilación.
+ *
+ * SolucionDF elige la instanciación en tiempo de ejecución; dentro del lazo no queda
+ * ninguna rama sobre el tipo de almacenamiento ni sobre la geometría. La malla es
+ * siempre de double, como la de VistaMalla y EspacioTrabajo.
+ */
+
+/**
+ * @brief Malla guardada por filas en un arreglo plano con paso de fila arbitrario.
+ */
+struct AlmacenamientoPlano {
+    static constexpr const char* nombre = "manual";
+
+    double* datos;
+    std::size_t paso;
+
+    double& operator()(int j, int i) { return datos[j * paso + i]; }
+};
+
+/**
+ * @brief Malla accedida como Eigen::Map por filas sobre memoria externa.
+ */
+struct AlmacenamientoEigen {
+    using Matriz = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    static constexpr const char* nombre = "Eigen";
+
+    Eigen::Map<Matriz, Eigen::Unaligned, Eigen::OuterStride<>> mapa;
+
+    AlmacenamientoEigen(double* datos, int filas, int columnas, std::size_t paso)
+        : mapa(datos, filas, columnas, Eigen::OuterStride<>(paso)) {}
+
+    double& operator()(int j, int i) { return mapa(j, i); }
+};
+
+/**
+ * @brief Estencil de 5 puntos: promedio de los cuatro vecinos.
+ */
+struct Estencil5Puntos {
+    template <typename Almacen>
+    static double promedio(Almacen& u, int j, int i) {
+        return 0.25 * (u(j+1, i) + u(j-1, i) + u(j, i+1) + u(j, i-1));
+    }
+};
+
+/**
+ * @brief Escalera de SolucionDF con tamaño de malla conocido en tiempo de ejecución.
+ *
+ * Las celdas fijas del interior son las de las filas (base_j, base_j + altura] y las
+ * columnas (ancho, 3 ancho]; en cada fila se devuelven como un rango [ini, fin).
+ */
+struct GeometriaEscalera {
+    int nx, ny, base_j, altura, ancho;
+
+    GeometriaEscalera(int nx_, int ny_)
+        : nx(nx_), ny(ny_), base_j(ny_ / 3), altura(ny_ / 3), ancho(nx_ / 4) {}
+
+    void hueco(int j, int& ini, int& fin) const {
+        if (j > base_j && j < base_j + altura + 1) {
+            ini = ancho + 1;
+            fin = 3 * ancho + 1;
+        } else {
+            ini = fin = nx;
+        }
+    }
+};
+
+/**
+ * @brief La misma escalera con nx y ny fijados en compilación (lazos de longitud constante).
+ */
+template <int NX, int NY>
+struct GeometriaEscaleraFija {
+    static constexpr int nx = NX, ny = NY;
+    static constexpr int base_j = NY / 3, altura = NY / 3, ancho = NX / 4;
+
+    void hueco(int j, int& ini, int& fin) const {
+        if (j > base_j && j < base_j + altura + 1) {
+            ini = ancho + 1;
+            fin = 3 * ancho + 1;
+        } else {
+            ini = fin = nx;
+        }
+    }
+};
+
+/**
+ * @brief Parámetro de sobrerrelajación leído en tiempo de ejecución.
+ */
+struct OmegaDinamico {
+    double lambda;
+    double valor() const { return lambda; }
+};
+
+/**
+ * @brief Parámetro de sobrerrelajación NUM / DEN conocido en compilación
+ *        (con 1/1 el término (1 - lambda) desaparece: Gauss-Seidel).
+ */
+template <int NUM, int DEN>
+struct OmegaFijo {
+    static constexpr double valor() { return static_cast<double>(NUM) / DEN; }
+};
+
+/**
+ * @brief Resultado de una resolución SOR.
+ */
+struct ResultadoSOR {
+    int iteraciones;
+    double error_max;
+};
+
+/**
+ * @brief Escribe las condiciones de frontera y la escalera en la malla.
+ */
+template <typename Almacen, typename Geometria>
+void AplicarFronteras(Almacen& u, const Geometria& g, double fronteraIzquierda, double base, double escalera) {
+    for (int j = 0; j <= g.ny; ++j) {
+        u(j, 0) = fronteraIzquierda;
+    }
+    for (int i = 0; i <= g.nx; ++i) {
+        u(0, i) = base;
+    }
+    for (int i = g.ancho; i <= 2 * g.ancho; ++i) {
+        u(g.base_j, i) = escalera;
+    }
+    for (int j = g.base_j; j <= g.base_j + g.altura; ++j) {
+        u(j, 2 * g.ancho) = escalera;
+    }
+    for (int i = 2 * g.ancho; i <= 3 * g.ancho; ++i) {
+        u(g.base_j + g.altura, i) = escalera;
+    }
+}
+
+/**
+ * @brief Barridos de sobrerrelajación hasta que el cambio máximo sea menor que la tolerancia.
+ *
+ * Cada fila se recorre en los tramos [1, ini) y [fin, nx) que deja libres la geometría,
+ * en el mismo orden que el lazo original, así que el resultado no cambia.
+ */
+template <typename Almacen, typename Estencil, typename Geometria, typename Omega>
+ResultadoSOR ResolverSOR(Almacen& u, const Geometria& g, const Omega& omega,
+                         double tolerancia, int max_iteraciones) {
+    const double w = omega.valor();
+
+    double error_max = 1;
+    int iteracion = 0;
+    while (error_max > tolerancia && iteracion < max_iteraciones) {
+        error_max = 0;
+        iteracion++;
+
+        for (int j = 1; j < g.ny; ++j) {
+            int ini, fin;
+            g.hueco(j, ini, fin);
+            if (ini >= fin) {
+                ini = fin = g.nx;
+            }
+            const int tramos[2][2] = {{1, ini < g.nx ? ini : g.nx}, {fin > 1 ? fin : 1, g.nx}};
+            for (int t = 0; t < (ini < g.nx ? 2 : 1); ++t) {
+                for (int i = tramos[t][0]; i < tramos[t][1]; ++i) {
+                    double anterior = u(j, i);
+                    double u_nuevo = Estencil::promedio(u, j, i);
+                    u(j, i) = (1 - w) * anterior + w * u_nuevo;
+                    double error_punto = std::abs(u(j, i) - anterior);
+                    if (error_punto > error_max) {
+                        error_max = error_punto;
+                    }
+                }
+            }
+        }
+    }
+    return ResultadoSOR{iteracion, error_max};
+}
+
+#endif // LAPLACE_KERNELS_H
@@ -0,0 +1,243 @@
+#include "capacitancia.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Precalcula las tablas del rectángulo y factoriza la matriz de capacitancia.
+ *
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ */
+SolucionadorCapacitancia::SolucionadorCapacitancia(int nx, int ny)
+    : geometria_(nx, ny), columnas_(nx - 1), dst_(std::max(1, nx - 1)) {
+    if (nx < 2 || ny < 2) {
+        return;
+    }
+    const int K = columnas_, filas = ny - 1;
+
+    // Modo k (índice k - 1): d_k = 4 - 2 cos(k pi / nx) = 2 cosh(mu_k)
+    std::vector<double> d(K), mu(K);
+    for (int m = 0; m < K; ++m) {
+        d[m] = 4.0 - 2.0 * std::cos(M_PI * (m + 1) / nx);
+        mu[m] = std::acosh(0.5 * d[m]);
+    }
+
+    // Eliminación de Thomas de -w_{j-1} + d_k w_j - w_{j+1} = f_j, igual para todos los lados derechos
+    inverso_.resize(static_cast<std::size_t>(filas) * K);
+    std::vector<double> c(K, 0.0);
+    for (int j = 0; j < filas; ++j) {
+        double* inv = &inverso_[static_cast<std::size_t>(j) * K];
+        for (int m = 0; m < K; ++m) {
+            inv[m] = 1.0 / (d[m] + c[m]);
+            c[m] = -inv[m];
+        }
+    }
+
+    // Gamma: celdas fijas con al menos un vecino libre del interior
+    for (int j = 1; j < ny; ++j) {
+        for (int i = 1; i < nx; ++i) {
+            if (!fija(j, i)) {
+                continue;
+            }
+            const int vecinos[4][2] = {{j - 1, i}, {j + 1, i}, {j, i - 1}, {j, i + 1}};
+            for (const auto& v : vecinos) {
+                if (v[0] > 0 && v[0] < ny && v[1] > 0 && v[1] < nx && !fija(v[0], v[1])) {
+                    gamma_j_.push_back(j);
+                    gamma_i_.push_back(i);
+                    break;
+                }
+            }
+        }
+    }
+    const int M = puntosCapacitancia();
+    if (M == 0) {
+        return;
+    }
+
+    // C(p, q) = (2 / nx) sum_k s_k(i_p) s_k(i_q) g_k(j_p, j_q), con la función de Green
+    // tridiagonal escrita con exponenciales para que no se desborde en los modos altos:
+    // g_k(j, J) = e^{-mu (J - j)} (1 - e^{-2 mu j}) (1 - e^{-2 mu (ny - J)}) / (2 sinh(mu) (1 - e^{-2 mu ny})), j <= J
+    int jmin = *std::min_element(gamma_j_.begin(), gamma_j_.end());
+    int jmax = *std::max_element(gamma_j_.begin(), gamma_j_.end());
+    std::vector<double> T(static_cast<std::size_t>(jmax - jmin + 1) * K);
+    for (int m = 0; m < K; ++m) {
+        double w = (2.0 / nx) / (2.0 * std::sinh(mu[m]) * -std::expm1(-2.0 * mu[m] * ny));
+        for (int dj = 0; dj <= jmax - jmin; ++dj) {
+            T[static_cast<std::size_t>(dj) * K + m] = w * std::exp(-mu[m] * dj);
+        }
+    }
+    std::vector<double> P(static_cast<std::size_t>(M) * K), Q(static_cast<std::size_t>(M) * K);
+    for (int p = 0; p < M; ++p) {
+        int j = gamma_j_[p], i = gamma_i_[p];
+        for (int m = 0; m < K; ++m) {
+            double s = std::sin(M_PI * ((static_cast<long long>(m + 1) * i) % (2 * nx)) / nx);
+            P[static_cast<std::size_t>(p) * K + m] = s * -std::expm1(-2.0 * mu[m] * j);
+            Q[static_cast<std::size_t>(p) * K + m] = s * -std::expm1(-2.0 * mu[m] * (ny - j));
+        }
+    }
+
+    Eigen::MatrixXd C(M, M);
+    for (int p = 0; p < M; ++p) {
+        for (int q = 0; q <= p; ++q) {
+            // El factor P va con la fila de abajo y Q con la de arriba
+            int abajo = gamma_j_[p] <= gamma_j_[q] ? p : q;
+            int arriba = abajo == p ? q : p;
+            const double* a = &P[static_cast<std::size_t>(abajo) * K];
+            const double* b = &Q[static_cast<std::size_t>(arriba) * K];
+            const double* t = &T[static_cast<std::size_t>(gamma_j_[arriba] - gamma_j_[abajo]) * K];
+            double suma[4] = {0.0, 0.0, 0.0, 0.0};
+            int m = 0;
+            for (; m + 4 <= K; m += 4) {
+                for (int r = 0; r < 4; ++r) {
+                    suma[r] += a[m + r] * b[m + r] * t[m + r];
+                }
+            }
+            for (; m < K; ++m) {
+                suma[0] += a[m] * b[m] * t[m];
+            }
+            C(p, q) = (suma[0] + suma[1]) + (suma[2] + suma[3]);
+        }
+    }
+    cholesky_.compute(C);
+}
+
+/**
+ * @brief Indica si la celda (j, i) del interior pertenece al bloque fijo de la escalera.
+ */
+bool SolucionadorCapacitancia::fija(int j, int i) const {
+    int ini, fin;
+    geometria_.hueco(j, ini, fin);
+    return i >= ini && i < fin;
+}
+
+/**
+ * @brief Aplica A^{-1} del rectángulo en el lugar: DST por filas, Thomas por modos y DST inversa.
+ *
+ * @param f Arreglo (ny - 1) x (nx - 1) por filas con el lado derecho; sale con la solución.
+ */
+void SolucionadorCapacitancia::resolverRectangulo(double* f) {
+    const int K = columnas_, filas = geometria_.ny - 1;
+    for (int j = 0; j < filas; j += 2) {
+        if (j + 1 < filas) {
+            dst_.transformar(f + static_cast<std::size_t>(j) * K, f + static_cast<std::size_t>(j + 1) * K);
+        } else {
+            dst_.transformar(f + static_cast<std::size_t>(j) * K);
+        }
+    }
+
+    // Thomas para todos los modos a la vez: cada paso recorre una fila completa
+    for (int m = 0; m < K; ++m) {
+        f[m] *= inverso_[m];
+    }
+    for (int j = 1; j < filas; ++j) {
+        double* fila = f + static_cast<std::size_t>(j) * K;
+        const double* previa = fila - K;
+        const double* inv = &inverso_[static_cast<std::size_t>(j) * K];
+        for (int m = 0; m < K; ++m) {
+            fila[m] = (fila[m] + previa[m]) * inv[m];
+        }
+    }
+    for (int j = filas - 2; j >= 0; --j) {
+        double* fila = f + static_cast<std::size_t>(j) * K;
+        const double* siguiente = fila + K;
+        const double* inv = &inverso_[static_cast<std::size_t>(j) * K];
+        for (int m = 0; m < K; ++m) {
+            fila[m] += inv[m] * siguiente[m];
+        }
+    }
+
+    const double escala = 2.0 / geometria_.nx;
+    for (int j = 0; j < filas; j += 2) {
+        double* a = f + static_cast<std::size_t>(j) * K;
+        if (j + 1 < filas) {
+            dst_.transformar(a, a + K);
+            for (int m = 0; m < 2 * K; ++m) {
+                a[m] *= escala;
+            }
+        } else {
+            dst_.transformar(a);
+            for (int m = 0; m < K; ++m) {
+                a[m] *= escala;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Resuelve el problema discreto sobre la malla.
+ *
+ * @param u Malla (ny + 1) x (nx + 1) con las fronteras y la escalera.
+ */
+void SolucionadorCapacitancia::resolver(VistaMalla& u) {
+    const int nx = geometria_.nx, ny = geometria_.ny;
+    if (nx < 2 || ny < 2) {
+        return;
+    }
+    const int K = columnas_, filas = ny - 1;
+
+    // Lado derecho del rectángulo: los valores de frontera vecinos de cada celda interior
+    rectangulo_.assign(static_cast<std::size_t>(filas) * K, 0.0);
+    auto f = [&](std::vector<double>& v, int j, int i) -> double& {
+        return v[static_cast<std::size_t>(j - 1) * K + (i - 1)];
+    };
+    for (int i = 1; i < nx; ++i) {
+        f(rectangulo_, 1, i) += u(0, i);
+        f(rectangulo_, ny - 1, i) += u(ny, i);
+    }
+    for (int j = 1; j < ny; ++j) {
+        f(rectangulo_, j, 1) += u(j, 0);
+        f(rectangulo_, j, nx - 1) += u(j, nx);
+    }
+
+    std::vector<double>* solucion = &rectangulo_;
+    const int M = puntosCapacitancia();
+    if (M > 0) {
+        cargas_ = rectangulo_;
+        resolverRectangulo(rectangulo_.data());
+
+        // Cargas en Gamma para que la solución valga lo que dicta la escalera
+        Eigen::VectorXd residuo(M);
+        for (int p = 0; p < M; ++p) {
+            residuo(p) = u(gamma_j_[p], gamma_i_[p]) - f(rectangulo_, gamma_j_[p], gamma_i_[p]);
+        }
+        Eigen::VectorXd sigma = cholesky_.solve(residuo);
+        for (int p = 0; p < M; ++p) {
+            f(cargas_, gamma_j_[p], gamma_i_[p]) += sigma(p);
+        }
+        resolverRectangulo(cargas_.data());
+        solucion = &cargas_;
+    } else {
+        resolverRectangulo(rectangulo_.data());
+    }
+
+    for (int j = 1; j < ny; ++j) {
+        for (int i = 1; i < nx; ++i) {
+            if (!fija(j, i)) {
+                u(j, i) = f(*solucion, j, i);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Escribe fronteras y escalera en la malla y la resuelve con un solucionador ya factorizado.
+ *
+ * @param fronteraIzquierda Valor constante de la condición de frontera en el lado izquierdo.
+ * @param base Valor constante de la condición de frontera en la base.
+ * @param escalera Valor constante de la condición de frontera en la escalera saliente.
+ * @param directo Solucionador construido para la malla nx x ny.
+ * @param espacio Espacio de trabajo que conserva la malla entre llamadas.
+ * @return Vista de la solución.
+ */
+VistaMalla SolucionDirecta(double fronteraIzquierda, double base, double escalera,
+                           SolucionadorCapacitancia& directo, EspacioTrabajo& espacio) {
+    const int nx = directo.nx(), ny = directo.ny();
+    VistaMalla solucion = espacio.malla(0, ny + 1, nx + 1);
+    for (int j = 0; j <= ny; ++j) {
+        std::fill(&solucion(j, 0), &solucion(j, 0) + nx + 1, 0.0);
+    }
+    AlmacenamientoPlano u{solucion.datos, solucion.paso};
+    AplicarFronteras(u, GeometriaEscalera(nx, ny), fronteraIzquierda, base, escalera);
+    directo.resolver(solucion);
+    return solucion;
+}
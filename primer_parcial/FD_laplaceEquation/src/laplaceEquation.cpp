@@ -9,7 +9,10 @@
 #include <unistd.h> // Para mkdir en Linux
 #include <cstdlib>
 #include <cmath>
-#include <Eigen/Dense>
+#include <algorithm>
+#include <sstream>
+#include "laplaceKernels.h"
+#include "capacitancia.h"
 
 /**
  * @brief Solicita al usuario los parámetros necesarios para resolver la ecuación de Laplace.
@@ -21,7 +24,7 @@
  * @param ny Número de divisiones en la dirección y de la malla.
  * @param lambda Parámetro de sobrerrelajación para el método de Gauss-Seidel.
  * @param criterioConvergencia Porcentaje de error relativo para la convergencia.
- * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen).
+ * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen, 3 para la solución directa).
  * @param opcionGrafica Entero que indica la herramienta de graficación a usar (1 para Python, 2 para Gnuplot).
  */
 void IngresarDatos(double& fronteraIzquierda, double& base, double& escalera,
@@ -71,11 +74,11 @@ void IngresarDatos(double& fronteraIzquierda, double& base, double& escalera,
 
     // Leer opción de implementación
     while (true) {
-        leerEntero("Opción de implementación (1: Manual C++, 2: Eigen): ", opcionImplementacion);
-        if (opcionImplementacion == 1 || opcionImplementacion == 2) {
+        leerEntero("Opción de implementación (1: Manual C++, 2: Eigen, 3: Directa DST + capacitancia): ", opcionImplementacion);
+        if (opcionImplementacion >= 1 && opcionImplementacion <= 3) {
             break;
         }
-        std::cout << "Opción no válida. Ingrese 1 o 2.\n";
+        std::cout << "Opción no válida. Ingrese 1, 2 o 3.\n";
     }
 
     // Leer opción de graficación
@@ -121,8 +124,8 @@ int VerificarDatos(double fronteraIzquierda, double base, double escalera,
         std::cerr << "Error: El criterio de convergencia debe ser positivo." << std::endl;
         return 5;
     }
-    if (opcionImplementacion != 1 && opcionImplementacion != 2) {
-        std::cerr << "Error: La opción de implementación no es válida (debe ser 1 o 2)." << std::endl;
+    if (opcionImplementacion < 1 || opcionImplementacion > 3) {
+        std::cerr << "Error: La opción de implementación no es válida (debe ser 1, 2 o 3)." << std::endl;
         return 6;
     }
     if (opcionGrafica != 1 && opcionGrafica != 2) {
@@ -141,150 +144,136 @@ int VerificarDatos(double fronteraIzquierda, double base, double escalera,
  * @param nx Número de divisiones en la dirección x de la malla.
  * @param ny Número de divisiones en la dirección y de la malla.
  * @param lambda Parámetro de sobrerrelajación (0 < lambda <= 2).
- * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen).
+ * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen, 3 para la solución directa).
  * @return La matriz de la solución.
  */
 std::vector<std::vector<double>> SolucionDF(double fronteraIzquierda, double base, double escalera,
                                            int nx, int ny, double lambda, int opcionImplementacion) {
-    std::vector<std::vector<double>> solucion_std;
+    EspacioTrabajo espacio;
+    VistaMalla vista = SolucionDF(fronteraIzquierda, base, escalera, nx, ny, lambda, opcionImplementacion, espacio);
+    if (vista.datos == nullptr) {
+        return std::vector<std::vector<double>>();
+    }
 
-    if (opcionImplementacion == 1) {
-        // Implementación manual en C++
-        std::vector<std::vector<double>> solucion(ny + 1, std::vector<double>(nx + 1, 0.0));
+    std::vector<std::vector<double>> solucion_std(ny + 1);
+    for (int j = 0; j <= ny; ++j) {
+        solucion_std[j].assign(&vista(j, 0), &vista(j, 0) + nx + 1);
+    }
+    return solucion_std;
+}
 
-        // Aplicar condiciones de frontera
-        for (int j = 0; j <= ny; ++j) {
-            solucion[j][0] = fronteraIzquierda;
-        }
-        for (int i = 0; i <= nx; ++i) {
-            solucion[0][i] = base;
-        }
-        int escalera_base_j = ny / 3;
-        int escalera_altura = ny / 3;
-        int escalera_ancho = nx / 4;
-        for (int i = escalera_ancho; i <= 2 * escalera_ancho; ++i) {
-            solucion[escalera_base_j][i] = escalera;
-        }
-        for (int j = escalera_base_j; j <= escalera_base_j + escalera_altura; ++j) {
-            solucion[j][2 * escalera_ancho] = escalera;
-        }
-        for (int i = 2 * escalera_ancho; i <= 3 * escalera_ancho; ++i) {
-            solucion[escalera_base_j + escalera_altura][i] = escalera;
-        }
+namespace {
 
-        double error_max = 1.0;
-        double tolerancia = 1e-6;
-        int iteracion = 0;
-        int max_iteraciones = 10000;
-        std::vector<std::vector<double>> solucion_anterior = solucion;
-
-        while (error_max > tolerancia && iteracion < max_iteraciones) {
-            error_max = 0.0;
-            iteracion++;
-
-            for (int j = 1; j < ny; ++j) {
-                for (int i = 1; i < nx; ++i) {
-                    if (!((j > escalera_base_j && j < escalera_base_j + escalera_altura + 1) && (i > escalera_ancho && i < 3 * escalera_ancho + 1))) {
-                        double u_nuevo = 0.25 * (solucion[j+1][i] + solucion[j-1][i] + solucion[j][i+1] + solucion[j][i-1]);
-                        solucion[j][i] = (1 - lambda) * solucion_anterior[j][i] + lambda * u_nuevo;
-                        double error_punto = std::abs(solucion[j][i] - solucion_anterior[j][i]);
-                        if (error_punto > error_max) {
-                            error_max = error_punto;
-                        }
-                    }
-                }
-            }
-            solucion_anterior = solucion;
-        }
-        if (error_max <= tolerancia) {
-            std::cout << "Solución manual convergió en " << iteracion << " iteraciones. Error máximo: " << error_max << std::endl;
-        } else {
-            std::cout << "Solución manual no convergió después de " << max_iteraciones << " iteraciones. Error máximo: " << error_max << std::endl;
-        }
-        solucion_std = solucion;
-
-    } else if (opcionImplementacion == 2) {
-        // Implementación con Eigen
-        Eigen::MatrixXd solucion_eigen(ny + 1, nx + 1);
-        solucion_eigen.setZero();
-
-        // Aplicar condiciones de frontera
-        solucion_eigen.col(0).fill(fronteraIzquierda);
-        solucion_eigen.row(0).fill(base);
-        int escalera_base_j = ny / 3;
-        int escalera_altura = ny / 3;
-        int escalera_ancho = nx / 4;
-        for (int i = escalera_ancho; i <= 2 * escalera_ancho; ++i) {
-            solucion_eigen(escalera_base_j, i) = escalera;
-        }
-        for (int j = escalera_base_j; j <= escalera_base_j + escalera_altura; ++j) {
-            solucion_eigen(j, 2 * escalera_ancho) = escalera;
-        }
-        for (int i = 2 * escalera_ancho; i <= 3 * escalera_ancho; ++i) {
-            solucion_eigen(escalera_base_j + escalera_altura, i) = escalera;
-        }
+/**
+ * @brief Resuelve con omega fijo en compilación para los valores habituales de lambda.
+ */
+template <typename Almacen, typename Geometria>
+ResultadoSOR DespacharOmega(Almacen& u, const Geometria& g, double lambda,
+                            double tolerancia, int max_iteraciones) {
+    if (lambda == 1.0) {
+        return ResolverSOR<Almacen, Estencil5Puntos>(u, g, OmegaFijo<1, 1>(), tolerancia, max_iteraciones);
+    }
+    if (lambda == 1.5) {
+        return ResolverSOR<Almacen, Estencil5Puntos>(u, g, OmegaFijo<3, 2>(), tolerancia, max_iteraciones);
+    }
+    if (lambda == 1.75) {
+        return ResolverSOR<Almacen, Estencil5Puntos>(u, g, OmegaFijo<7, 4>(), tolerancia, max_iteraciones);
+    }
+    return ResolverSOR<Almacen, Estencil5Puntos>(u, g, OmegaDinamico{lambda}, tolerancia, max_iteraciones);
+}
 
-        double error_max = 1.0;
-        double tolerancia = 1e-6;
-        int iteracion = 0;
-        int max_iteraciones = 10000;
-        Eigen::MatrixXd solucion_anterior_eigen = solucion_eigen;
-
-        while (error_max > tolerancia && iteracion < max_iteraciones) {
-            error_max = 0.0;
-            iteracion++;
-
-            for (int j = 1; j < ny; ++j) {
-                for (int i = 1; i < nx; ++i) {
-                   if (!((j > escalera_base_j && j < escalera_base_j + escalera_altura + 1) && (i > escalera_ancho && i < 3 * escalera_ancho + 1))) {
-                        double u_nuevo = 0.25 * (solucion_eigen(j+1,i) + solucion_eigen(j-1,i) + solucion_eigen(j,i+1) + solucion_eigen(j,i-1));
-                        solucion_eigen(j,i) = (1 - lambda) * solucion_anterior_eigen(j,i) + lambda * u_nuevo;
-                        double error_punto = std::abs(solucion_eigen(j,i) - solucion_anterior_eigen(j,i));
-                        if (error_punto > error_max) {
-                            error_max = error_punto;
-                        }
-                    }
-                }
-            }
-            solucion_anterior_eigen = solucion_eigen;
-        }
+/**
+ * @brief Aplica las fronteras y resuelve, con la escalera fija en compilación para las mallas habituales.
+ */
+template <typename Almacen>
+ResultadoSOR DespacharGeometria(Almacen& u, int nx, int ny, double lambda,
+                                double fronteraIzquierda, double base, double escalera,
+                                double tolerancia, int max_iteraciones) {
+    if (nx == 100 && ny == 100) {
+        GeometriaEscaleraFija<100, 100> g;
+        AplicarFronteras(u, g, fronteraIzquierda, base, escalera);
+        return DespacharOmega(u, g, lambda, tolerancia, max_iteraciones);
+    }
+    if (nx == 20 && ny == 20) {
+        GeometriaEscaleraFija<20, 20> g;
+        AplicarFronteras(u, g, fronteraIzquierda, base, escalera);
+        return DespacharOmega(u, g, lambda, tolerancia, max_iteraciones);
+    }
+    GeometriaEscalera g(nx, ny);
+    AplicarFronteras(u, g, fronteraIzquierda, base, escalera);
+    return DespacharOmega(u, g, lambda, tolerancia, max_iteraciones);
+}
 
-        if (error_max <= tolerancia) {
-            std::cout << "Solución Eigen convergió en " << iteracion << " iteraciones. Error máximo: " << error_max << std::endl;
-        } else {
-            std::cout << "Solución Eigen no convergió después de " << max_iteraciones << " iteraciones. Error máximo: " << error_max << std::endl;
-        }
+} // namespace
 
-        solucion_std.resize(ny + 1);
-        for (int j = 0; j <= ny; ++j) {
-            solucion_std[j].resize(nx + 1);
-            for (int i = 0; i <= nx; ++i) {
-                solucion_std[j][i] = solucion_eigen(j, i);
-            }
-        }
-    } else {
+/**
+ * @brief Resuelve la ecuación de Laplace sobre la memoria de un espacio de trabajo.
+ *
+ * @param fronteraIzquierda Valor constante de la condición de frontera en el lado izquierdo.
+ * @param base Valor constante de la condición de frontera en la base.
+ * @param escalera Valor constante de la condición de frontera en la escalera saliente.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param lambda Parámetro de sobrerrelajación (0 < lambda <= 2).
+ * @param opcionImplementacion Entero que indica la implementación a usar (1 para manual, 2 para Eigen, 3 para la solución directa).
+ * @param espacio Espacio de trabajo que conserva la malla entre llamadas.
+ * @return Vista de la solución (datos nulos si la opción no es válida).
+ */
+VistaMalla SolucionDF(double fronteraIzquierda, double base, double escalera,
+                      int nx, int ny, double lambda, int opcionImplementacion,
+                      EspacioTrabajo& espacio) {
+    if (opcionImplementacion < 1 || opcionImplementacion > 3) {
         std::cerr << "Opción de implementación no válida." << std::endl;
-        return std::vector<std::vector<double>>();
+        return VistaMalla{nullptr, 0, 0, 0};
     }
 
-    return solucion_std;
+    if (opcionImplementacion == 3) {
+        // Solución exacta del sistema discreto: no depende de lambda ni itera
+        SolucionadorCapacitancia directo(nx, ny);
+        VistaMalla solucion = SolucionDirecta(fronteraIzquierda, base, escalera, directo, espacio);
+        std::cout << "Solución directa (DST + capacitancia) con " << directo.puntosCapacitancia()
+                  << " puntos de capacitancia en la escalera." << std::endl;
+        return solucion;
+    }
+
+    // Cada punto se actualiza una sola vez por barrido, así que el valor "anterior"
+    // es el que tiene antes de actualizarlo: no hace falta una copia de la malla.
+    VistaMalla solucion = espacio.malla(0, ny + 1, nx + 1);
+    for (int j = 0; j <= ny; ++j) {
+        std::fill(&solucion(j, 0), &solucion(j, 0) + nx + 1, 0.0);
+    }
+
+    double tolerancia = 1e-6;
+    int max_iteraciones = 10000;
+    ResultadoSOR resultado;
+    std::string nombre;
+    if (opcionImplementacion == 1) {
+        AlmacenamientoPlano u{solucion.datos, solucion.paso};
+        resultado = DespacharGeometria(u, nx, ny, lambda, fronteraIzquierda, base, escalera, tolerancia, max_iteraciones);
+        nombre = AlmacenamientoPlano::nombre;
+    } else {
+        AlmacenamientoEigen u(solucion.datos, ny + 1, nx + 1, solucion.paso);
+        resultado = DespacharGeometria(u, nx, ny, lambda, fronteraIzquierda, base, escalera, tolerancia, max_iteraciones);
+        nombre = AlmacenamientoEigen::nombre;
+    }
+
+    if (resultado.error_max <= tolerancia) {
+        std::cout << "Solución " << nombre << " convergió en " << resultado.iteraciones << " iteraciones. Error máximo: " << resultado.error_max << std::endl;
+    } else {
+        std::cout << "Solución " << nombre << " no convergió después de " << max_iteraciones << " iteraciones. Error máximo: " << resultado.error_max << std::endl;
+    }
+    return solucion;
 }
 
+namespace {
+
 /**
- * @brief Genera un archivo con los datos de la solución de la ecuación de Laplace.
- *
- * @param solucion La matriz bidimensional que contiene los valores de la solución.
- * @param nx Número de divisiones en la dirección x de la malla.
- * @param ny Número de divisiones en la dirección y de la malla.
- * @param lambda Parámetro de sobrerrelajación utilizado.
- * @param fronteraIzquierda Valor de la frontera izquierda.
- * @param base Valor de la base.
- * @param escalera Valor de la escalera saliente.
- * @return El nombre del archivo generado.
+ * @brief Escribe la matriz de la solución en generate_files; valor(j, i) devuelve cada elemento.
  */
-std::string GenerarDatos(const std::vector<std::vector<double>>& solucion,
-                           int nx, int ny, double lambda,
-                           double fronteraIzquierda, double base, double escalera) {
+template <typename Valor>
+std::string EscribirSolucion(int filas, int columnas, Valor valor,
+                             int nx, int ny, double lambda,
+                             double fronteraIzquierda, double base, double escalera) {
     // Obtener la fecha y hora actual
     auto now = std::chrono::system_clock::now();
     auto now_c = std::chrono::system_clock::to_time_t(now);
@@ -313,11 +302,11 @@ std::string GenerarDatos(const std::vector<std::vector<double>>& solucion,
     // Abrir el archivo y escribir los datos
     std::ofstream outputFile(filename);
     if (outputFile.is_open()) {
-        for (const auto& row : solucion) {
-            for (double value : row) {
-                outputFile << value << " ";
+        for (int j = 0; j < filas; ++j) {
+            for (int i = 0; i < columnas; ++i) {
+                outputFile << valor(j, i) << " ";
             }
-            outputFile << std::endl;
+            outputFile << '\n';
         }
         outputFile.close();
         std::cout << "Datos de la solución guardados en: " << filename << std::endl;
@@ -329,6 +318,49 @@ std::string GenerarDatos(const std::vector<std::vector<double>>& solucion,
     return filename;
 }
 
+} // namespace
+
+/**
+ * @brief Genera un archivo con los datos de la solución de la ecuación de Laplace.
+ *
+ * @param solucion La matriz bidimensional que contiene los valores de la solución.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param lambda Parámetro de sobrerrelajación utilizado.
+ * @param fronteraIzquierda Valor de la frontera izquierda.
+ * @param base Valor de la base.
+ * @param escalera Valor de la escalera saliente.
+ * @return El nombre del archivo generado.
+ */
+std::string GenerarDatos(const std::vector<std::vector<double>>& solucion,
+                           int nx, int ny, double lambda,
+                           double fronteraIzquierda, double base, double escalera) {
+    int columnas = solucion.empty() ? 0 : static_cast<int>(solucion[0].size());
+    return EscribirSolucion(static_cast<int>(solucion.size()), columnas,
+                            [&](int j, int i) { return solucion[j][i]; },
+                            nx, ny, lambda, fronteraIzquierda, base, escalera);
+}
+
+/**
+ * @brief Genera un archivo con los datos de una solución guardada en una vista de malla.
+ *
+ * @param solucion Vista de la malla con la solución.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param lambda Parámetro de sobrerrelajación utilizado.
+ * @param fronteraIzquierda Valor de la frontera izquierda.
+ * @param base Valor de la base.
+ * @param escalera Valor de la escalera saliente.
+ * @return El nombre del archivo generado.
+ */
+std::string GenerarDatos(const VistaMalla& solucion,
+                           int nx, int ny, double lambda,
+                           double fronteraIzquierda, double base, double escalera) {
+    return EscribirSolucion(solucion.filas, solucion.columnas,
+                            [&](int j, int i) { return solucion(j, i); },
+                            nx, ny, lambda, fronteraIzquierda, base, escalera);
+}
+
 /**
  * @brief Genera un gráfico de la solución de la ecuación de Laplace.
  *
@@ -1,50 +1,103 @@
 #include "laplaceEquation.h"
+#include "pipelineSalida.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
 
 /**
  * @brief Función principal del programa para resolver la ecuación de Laplace.
  *
+ * Los argumentos opcionales son valores adicionales de lambda para un barrido:
+ * ./FD_LaplaceEquation 1.5 1.9 resuelve con el lambda ingresado, luego con 1.5 y 1.9.
+ * La escritura y la gráfica de cada solución corren en hilos de fondo mientras se
+ * calcula la siguiente.
+ *
+ * @param argc Número de argumentos.
+ * @param argv Valores adicionales de lambda.
  * @return Código de salida del programa.
  */
-int main() {
+int main(int argc, char* argv[]) {
     double fronteraIzquierda, base, escalera, lambda, criterioConvergencia;
     int nx, ny, opcionImplementacion, opcionGrafica;
-    std::string nombreArchivo;
 
     // 1. Obtener los datos de entrada del usuario
     IngresarDatos(fronteraIzquierda, base, escalera, nx, ny, lambda, criterioConvergencia, opcionImplementacion, opcionGrafica);
 
     // 2. Verificar los datos ingresados
-    int codigoError = VerificarDatos(fronteraIzquierda, base, escalera, nx, ny, lambda, criterioConvergencia, opcionImplementacion, opcionGrafica);
-    if (codigoError != 0) {
-        std::cerr << "Error en los datos de entrada. El programa terminará." << std::endl;
-        return codigoError;
+    std::vector<double> lambdas = {lambda};
+    for (int k = 1; k < argc; ++k) {
+        lambdas.push_back(std::atof(argv[k]));
+    }
+    for (double l : lambdas) {
+        int codigoError = VerificarDatos(fronteraIzquierda, base, escalera, nx, ny, l, criterioConvergencia, opcionImplementacion, opcionGrafica);
+        if (codigoError != 0) {
+            std::cerr << "Error en los datos de entrada. El programa terminará." << std::endl;
+            return codigoError;
+        }
     }
 
-    // 3. Resolver la ecuación de Laplace
-    std::cout << "Resolviendo la ecuación de Laplace..." << std::endl;
-    std::vector<std::vector<double>> solucion = SolucionDF(fronteraIzquierda, base, escalera, nx, ny, lambda, opcionImplementacion);
+    // Etapas de salida: la escritura pasa cada archivo a la etapa de gráficas.
+    // Se destruyen en orden inverso: primero 'escritura' (que aún puede encolar en
+    // 'graficas' y marcar 'errorSalida'), luego 'graficas' y al final 'errorSalida'.
+    // Las instantáneas salen de un juego fijo de buffers del tamaño de la etapa de
+    // escritura (cola + trabajador + la que se está copiando).
+    const std::size_t colaEscritura = 2;
+    std::atomic<bool> errorSalida(false);
+    BuffersSalida instantaneas(colaEscritura + 2);
+    PipelineSalida graficas(2);
+    PipelineSalida escritura(colaEscritura);
 
-     if (solucion.empty())
-    {
-        std::cerr << "Error al resolver la ecuación de Laplace. El programa terminará." << std::endl;
-        return 1;
+    // La malla del solucionador se reutiliza en todo el barrido
+    EspacioTrabajo espacio;
+
+    for (double l : lambdas) {
+        // 3. Resolver la ecuación de Laplace
+        std::cout << "Resolviendo la ecuación de Laplace (lambda = " << l << ")..." << std::endl;
+        VistaMalla vista = SolucionDF(fronteraIzquierda, base, escalera, nx, ny, l, opcionImplementacion, espacio);
+
+        if (vista.datos == nullptr)
+        {
+            std::cerr << "Error al resolver la ecuación de Laplace. El programa terminará." << std::endl;
+            return 1;
+        }
+
+        // 4 y 5. Generar el archivo de datos y graficar en segundo plano, a partir de
+        // una instantánea porque la siguiente resolución sobrescribe el espacio
+        std::size_t tamano = static_cast<std::size_t>(vista.filas) * vista.paso;
+        std::size_t ranura = instantaneas.tomar(tamano);
+        VistaMalla copia = vista;
+        copia.datos = instantaneas.datos(ranura);
+        std::copy(vista.datos, vista.datos + tamano, copia.datos);
+
+        escritura.encolar([&, l, copia, ranura]() {
+            std::string nombreArchivo;
+            try {
+                nombreArchivo = GenerarDatos(copia, nx, ny, l, fronteraIzquierda, base, escalera);
+            } catch (...) {
+                instantaneas.liberar(ranura);
+                throw;
+            }
+            instantaneas.liberar(ranura);
+            if (nombreArchivo == "") {
+                std::cerr << "Error al generar el archivo de datos." << std::endl;
+                errorSalida = true;
+                return;
+            }
+            graficas.encolar([nombreArchivo, opcionGrafica]() {
+                Graficar(nombreArchivo, opcionGrafica);
+            });
+        });
     }
 
-    // 4. Generar el archivo de datos
-    std::cout << "Generando archivo de datos..." << std::endl;
-    nombreArchivo = GenerarDatos(solucion, nx, ny, lambda, fronteraIzquierda, base, escalera);
-    if (nombreArchivo == "") {
-        std::cerr << "Error al generar el archivo de datos. El programa terminará." << std::endl;
+    escritura.esperar();
+    graficas.esperar();
+    if (errorSalida) {
         return 1;
     }
 
-    // 5. Graficar la solución
-    std::cout << "Graficando la solución..." << std::endl;
-    Graficar(nombreArchivo, opcionGrafica);
-
     std::cout << "Programa terminado." << std::endl;
     return 0;
 }
-
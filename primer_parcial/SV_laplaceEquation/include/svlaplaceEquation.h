@@ -0,0 +1,91 @@
+#ifndef SV_LAPLACE_EQUATION_H
+#define SV_LAPLACE_EQUATION_H
+
+#include <vector>
+#include <string>
+
+/**
+ * @brief Solicita al usuario los parámetros de la solución por separación de variables.
+ *
+ * @param fronteraIzquierda Valor constante para la frontera izquierda.
+ * @param base Valor constante para la base.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param tolerancia Error absoluto máximo admitido al truncar la serie.
+ * @param opcionGrafica Entero que indica la herramienta de graficación a usar (1 para Python, 2 para Gnuplot).
+ */
+void IngresarDatos(double& fronteraIzquierda, double& base, int& nx, int& ny,
+                   double& tolerancia, int& opcionGrafica);
+
+/**
+ * @brief Verifica si los parámetros ingresados por el usuario son válidos.
+ *
+ * @param fronteraIzquierda Valor de la frontera izquierda a verificar.
+ * @param base Valor de la base a verificar.
+ * @param nx Número de divisiones en la dirección x de la malla a verificar.
+ * @param ny Número de divisiones en la dirección y de la malla a verificar.
+ * @param tolerancia Tolerancia de truncamiento a verificar.
+ * @param opcionGrafica Opción de graficación a verificar.
+ * @return Un código de error:
+ * - 0: No hay error, todos los datos son válidos.
+ * - 1: Error: Al menos uno de los valores de frontera es menor que cero.
+ * - 3: Error: El número de divisiones nx o ny no es válido.
+ * - 5: Error: La tolerancia no es positiva.
+ * - 7: Error: La opción de graficación no es válida.
+ */
+int VerificarDatos(double fronteraIzquierda, double base, int nx, int ny,
+                   double tolerancia, int opcionGrafica);
+
+/**
+ * @brief Número de modos impares necesarios para que la cola de la serie
+ *        sum_{n > M} (4 |amplitud| / (n pi)) e^{-n pi d / ancho} quede por debajo de la tolerancia.
+ *
+ * @param amplitud Valor de la frontera que genera la serie.
+ * @param distancia Distancia del punto a esa frontera (d > 0).
+ * @param ancho Longitud de la frontera (período de los senos).
+ * @param tolerancia Error absoluto admitido.
+ * @return El último modo M que hay que sumar (impar, al menos 1).
+ */
+int ModosNecesarios(double amplitud, double distancia, double ancho, double tolerancia);
+
+/**
+ * @brief Resuelve la ecuación de Laplace en el rectángulo [0, nx] x [0, ny] por separación de variables.
+ *
+ * Las condiciones de frontera son las del problema de diferencias finitas sin la escalera:
+ * frontera izquierda y base constantes, lados derecho y superior en cero. La serie de
+ * Fourier de cada frontera se trunca fila por fila (o columna por columna) según la
+ * tolerancia, usa cocientes de sinh escalados con exponenciales y se evalúa sobre toda
+ * la fila con una DST cuando hay muchos modos, o con tablas de senos cuando hay pocos.
+ *
+ * @param fronteraIzquierda Valor constante de la frontera izquierda.
+ * @param base Valor constante de la base.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param tolerancia Error absoluto máximo de truncamiento en cada punto interior.
+ * @return La matriz de la solución, solucion[j][i] con j en y e i en x.
+ */
+std::vector<std::vector<double>> SolucionSV(double fronteraIzquierda, double base,
+                                            int nx, int ny, double tolerancia);
+
+/**
+ * @brief Genera un archivo con los datos de la solución por separación de variables.
+ *
+ * @param solucion La matriz bidimensional que contiene los valores de la solución.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param fronteraIzquierda Valor de la frontera izquierda.
+ * @param base Valor de la base.
+ * @return El nombre del archivo generado.
+ */
+std::string GenerarDatos(const std::vector<std::vector<double>>& solucion,
+                         int nx, int ny, double fronteraIzquierda, double base);
+
+/**
+ * @brief Genera un gráfico de la solución.
+ *
+ * @param nombreArchivo Nombre del archivo de datos.
+ * @param opcionGrafica Opción de la herramienta de graficación (1: Python/Matplotlib, 2: Gnuplot).
+ */
+void Graficar(const std::string& nombreArchivo, int opcionGrafica);
+
+#endif // SV_LAPLACE_EQUATION_H
@@ -0,0 +1,18 @@
+# Uso: gnuplot -e "data_file='generate_files/solucionSV_...dat'" scripts/plot_svlaplace.gp
+# Configuración del terminal para PNG
+set terminal png
+system "mkdir -p graph"
+set output "graph/solucionSV.png"
+# Configuración del título
+set title "Solución de la Ecuación de Laplace (separación de variables)"
+
+# Etiquetas de los ejes
+set xlabel "X"
+set ylabel "Y"
+set zlabel "Solución"
+
+# Configuración de la vista 3D
+set view 60, 30, 1, 1
+
+# Graficar la superficie (el archivo es una matriz: fila j, columna i)
+splot data_file matrix with pm3d title "Solución"
@@ -0,0 +1,339 @@
+#include "svlaplaceEquation.h"
+#include "transformadas.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <limits>
+#include <thread>
+#include <algorithm>
+#include <sys/stat.h>
+#include <unistd.h> // Para mkdir en Linux
+#include <cstdlib>
+#include <cerrno>
+#include <cmath>
+
+namespace {
+
+const double PI = 3.141592653589793;
+
+/**
+ * @brief Evalúa la serie de una frontera de valor constante sobre las líneas paralelas a ella.
+ *
+ * La frontera tiene longitud nPuntos y el lado opuesto está a distancia nLineas. Para cada
+ * línea l = 1..nLineas-1 se calcula
+ *   u(t) = sum_{m impar} (4 amplitud / (m pi)) sinh(k (nLineas - l)) / sinh(k nLineas) sin(m pi t / nPuntos),
+ * con k = m pi / nPuntos, en t = 1..nPuntos-1, y se entrega a sumar(l, valores).
+ *
+ * @param amplitud Valor de la frontera.
+ * @param nPuntos Divisiones a lo largo de la frontera.
+ * @param nLineas Divisiones en la dirección perpendicular.
+ * @param tolerancia Error absoluto admitido al truncar la serie.
+ * @param sumar Función que acumula los valores de la línea l en la solución.
+ */
+template <typename Sumar>
+void EvaluarSerie(double amplitud, int nPuntos, int nLineas, double tolerancia, Sumar sumar) {
+    if (amplitud == 0.0 || nPuntos < 2 || nLineas < 2) {
+        return;
+    }
+    const double ancho = nPuntos, alto = nLineas;
+    const int n = nPuntos - 1;
+    const int periodo = 2 * nPuntos;
+
+    // sin(m pi t / nPuntos) = tablaSeno[(m t) mod periodo]
+    std::vector<double> tablaSeno(periodo);
+    for (int t = 0; t < periodo; ++t) {
+        tablaSeno[t] = std::sin(PI * t / nPuntos);
+    }
+    // Con pocos modos la suma directa es más barata que la DST
+    const int umbralDirecto = static_cast<int>(4 * std::log2(static_cast<double>(periodo)));
+
+    auto trabajador = [&](int l0, int l1) {
+        PlanDST plan(n);
+        std::vector<double> a(n), b(n), directo(n);
+        int pendiente = -1; // línea cuyos coeficientes esperan en 'a' para transformarse en pareja
+
+        for (int l = l0; l < l1; ++l) {
+            int ultimoModo = ModosNecesarios(amplitud, l, ancho, tolerancia);
+            // Cociente de sinh estable: e^{-k l} (1 - e^{-2k(alto - l)}) / (1 - e^{-2k alto})
+            auto coeficiente = [&](int m) {
+                double k = m * PI / ancho;
+                return 4.0 * amplitud / (m * PI) * std::exp(-k * l)
+                       * std::expm1(-2.0 * k * (alto - l)) / std::expm1(-2.0 * k * alto);
+            };
+
+            if ((ultimoModo + 1) / 2 <= umbralDirecto) {
+                std::fill(directo.begin(), directo.end(), 0.0);
+                for (int m = 1; m <= ultimoModo; m += 2) {
+                    double c = coeficiente(m);
+                    int salto = m % periodo, indice = 0;
+                    for (int t = 0; t < n; ++t) {
+                        indice += salto;
+                        if (indice >= periodo) indice -= periodo;
+                        directo[t] += c * tablaSeno[indice];
+                    }
+                }
+                sumar(l, directo.data());
+                continue;
+            }
+
+            // Los modos m >= nPuntos se pliegan sobre 1..nPuntos-1 (aliasing en la malla)
+            std::vector<double>& coef = (pendiente < 0) ? a : b;
+            std::fill(coef.begin(), coef.end(), 0.0);
+            for (int m = 1; m <= ultimoModo; m += 2) {
+                int r = m % periodo;
+                if (r < nPuntos) {
+                    coef[r - 1] += coeficiente(m);
+                } else if (r > nPuntos) {
+                    coef[periodo - r - 1] -= coeficiente(m);
+                }
+            }
+            if (pendiente < 0) {
+                pendiente = l;
+            } else {
+                plan.transformar(a.data(), b.data());
+                sumar(pendiente, a.data());
+                sumar(l, b.data());
+                pendiente = -1;
+            }
+        }
+        if (pendiente >= 0) {
+            plan.transformar(a.data());
+            sumar(pendiente, a.data());
+        }
+    };
+
+    int lineas = nLineas - 1;
+    int nHilos = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), lineas));
+    std::vector<std::thread> hilos;
+    for (int h = 1; h < nHilos; ++h) {
+        hilos.emplace_back(trabajador, 1 + h * lineas / nHilos, 1 + (h + 1) * lineas / nHilos);
+    }
+    trabajador(1, 1 + lineas / nHilos);
+    for (auto& hilo : hilos) {
+        hilo.join();
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Solicita al usuario los parámetros de la solución por separación de variables.
+ *
+ * @param fronteraIzquierda Valor constante para la frontera izquierda.
+ * @param base Valor constante para la base.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param tolerancia Error absoluto máximo admitido al truncar la serie.
+ * @param opcionGrafica Entero que indica la herramienta de graficación a usar (1 para Python, 2 para Gnuplot).
+ */
+void IngresarDatos(double& fronteraIzquierda, double& base, int& nx, int& ny,
+                   double& tolerancia, int& opcionGrafica) {
+    std::cout << "Ingrese los siguientes parámetros:" << std::endl;
+
+    // Función auxiliar para leer valores con validación
+    auto leer = [](const std::string& mensaje, auto& valor) {
+        while (true) {
+            std::cout << mensaje;
+            std::cin >> valor;
+            if (std::cin.fail()) {
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "Entrada no válida. Intente de nuevo.\n";
+            } else {
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                break;
+            }
+        }
+    };
+
+    leer("Condición de frontera izquierda: ", fronteraIzquierda);
+    leer("Condición de frontera base: ", base);
+    leer("Número de divisiones en x (nx): ", nx);
+    leer("Número de divisiones en y (ny): ", ny);
+    leer("Tolerancia de truncamiento de la serie: ", tolerancia);
+
+    // Leer opción de graficación
+    while (true) {
+        leer("Opción de graficación (1: Python/Matplotlib, 2: Gnuplot): ", opcionGrafica);
+        if (opcionGrafica == 1 || opcionGrafica == 2) {
+            break;
+        }
+        std::cout << "Opción no válida. Ingrese 1 o 2.\n";
+    }
+}
+
+/**
+ * @brief Verifica si los parámetros ingresados por el usuario son válidos.
+ *
+ * @param fronteraIzquierda Valor de la frontera izquierda a verificar.
+ * @param base Valor de la base a verificar.
+ * @param nx Número de divisiones en la dirección x de la malla a verificar.
+ * @param ny Número de divisiones en la dirección y de la malla a verificar.
+ * @param tolerancia Tolerancia de truncamiento a verificar.
+ * @param opcionGrafica Opción de graficación a verificar.
+ * @return Un código de error (0 si no hay error).
+ */
+int VerificarDatos(double fronteraIzquierda, double base, int nx, int ny,
+                   double tolerancia, int opcionGrafica) {
+    if (fronteraIzquierda < 0 || base < 0) {
+        std::cerr << "Error: Al menos uno de los valores de frontera es menor que cero." << std::endl;
+        return 1;
+    }
+    if (nx <= 0 || ny <= 0) {
+        std::cerr << "Error: El número de divisiones nx y ny debe ser mayor que cero." << std::endl;
+        return 3;
+    }
+    if (tolerancia <= 0) {
+        std::cerr << "Error: La tolerancia debe ser positiva." << std::endl;
+        return 5;
+    }
+    if (opcionGrafica != 1 && opcionGrafica != 2) {
+        std::cerr << "Error: La opción de graficación no es válida (debe ser 1 o 2)." << std::endl;
+        return 7;
+    }
+    return 0;
+}
+
+/**
+ * @brief Número de modos impares necesarios para truncar la serie con la tolerancia dada.
+ *
+ * Como cada cociente de sinh está acotado por e^{-n pi d / ancho}, la cola desde M + 2 es
+ * menor que (4 |amplitud| / pi) e^{-M pi d / ancho} / (1 - e^{-2 pi d / ancho}).
+ *
+ * @param amplitud Valor de la frontera que genera la serie.
+ * @param distancia Distancia del punto a esa frontera (d > 0).
+ * @param ancho Longitud de la frontera (período de los senos).
+ * @param tolerancia Error absoluto admitido.
+ * @return El último modo M que hay que sumar (impar), o 0 si la amplitud es nula.
+ */
+int ModosNecesarios(double amplitud, double distancia, double ancho, double tolerancia) {
+    if (amplitud == 0.0) {
+        return 0;
+    }
+    double q = std::exp(-2.0 * PI * distancia / ancho);
+    double cota = 4.0 * std::abs(amplitud) / (PI * tolerancia * (1.0 - q));
+    double modos = ancho / (PI * distancia) * std::log(std::max(cota, 1.0));
+    int ultimo = static_cast<int>(std::min(std::ceil(modos), 1e8));
+    if (ultimo < 1) ultimo = 1;
+    if (ultimo % 2 == 0) ++ultimo;
+    return ultimo;
+}
+
+/**
+ * @brief Resuelve la ecuación de Laplace en el rectángulo por separación de variables.
+ *
+ * @param fronteraIzquierda Valor constante de la frontera izquierda.
+ * @param base Valor constante de la base.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param tolerancia Error absoluto máximo de truncamiento en cada punto interior.
+ * @return La matriz de la solución.
+ */
+std::vector<std::vector<double>> SolucionSV(double fronteraIzquierda, double base,
+                                            int nx, int ny, double tolerancia) {
+    std::vector<std::vector<double>> solucion(ny + 1, std::vector<double>(nx + 1, 0.0));
+
+    // Fronteras en el mismo orden que SolucionDF (la base sobrescribe la esquina)
+    for (int j = 0; j <= ny; ++j) {
+        solucion[j][0] = fronteraIzquierda;
+    }
+    for (int i = 0; i <= nx; ++i) {
+        solucion[0][i] = base;
+    }
+
+    // Superposición: serie de la base (a lo largo de x) + serie de la frontera izquierda (a lo largo de y)
+    EvaluarSerie(base, nx, ny, 0.5 * tolerancia, [&](int j, const double* valores) {
+        for (int i = 1; i < nx; ++i) {
+            solucion[j][i] += valores[i - 1];
+        }
+    });
+    EvaluarSerie(fronteraIzquierda, ny, nx, 0.5 * tolerancia, [&](int i, const double* valores) {
+        for (int j = 1; j < ny; ++j) {
+            solucion[j][i] += valores[j - 1];
+        }
+    });
+
+    std::cout << "Solución por separación de variables calculada con tolerancia " << tolerancia << std::endl;
+    return solucion;
+}
+
+/**
+ * @brief Genera un archivo con los datos de la solución por separación de variables.
+ *
+ * @param solucion La matriz bidimensional que contiene los valores de la solución.
+ * @param nx Número de divisiones en la dirección x de la malla.
+ * @param ny Número de divisiones en la dirección y de la malla.
+ * @param fronteraIzquierda Valor de la frontera izquierda.
+ * @param base Valor de la base.
+ * @return El nombre del archivo generado.
+ */
+std::string GenerarDatos(const std::vector<std::vector<double>>& solucion,
+                         int nx, int ny, double fronteraIzquierda, double base) {
+    // Obtener la fecha y hora actual
+    auto now = std::chrono::system_clock::now();
+    auto now_c = std::chrono::system_clock::to_time_t(now);
+    std::stringstream ss;
+    ss << std::put_time(std::localtime(&now_c), "%Y%m%d_%H%M%S");
+    std::string timestamp = ss.str();
+
+    // Crear el nombre del archivo
+    std::string dirname = "generate_files";
+    std::string filename = dirname + "/solucionSV_" + timestamp +
+                           "_nx" + std::to_string(nx) +
+                           "_ny" + std::to_string(ny) +
+                           "_fi" + std::to_string(static_cast<int>(fronteraIzquierda)) +
+                           "_b" + std::to_string(static_cast<int>(base)) +
+                           ".dat";
+
+    // Crear el directorio si no existe
+    int dir_result = mkdir(dirname.c_str(), 0777);
+    if (dir_result != 0 && errno != EEXIST) {
+        std::cerr << "Error al crear el directorio " << dirname << std::endl;
+        return "";
+    }
+
+    // Abrir el archivo y escribir los datos
+    std::ofstream outputFile(filename);
+    if (outputFile.is_open()) {
+        for (const auto& row : solucion) {
+            for (double value : row) {
+                outputFile << value << " ";
+            }
+            outputFile << '\n';
+        }
+        outputFile.close();
+        std::cout << "Datos de la solución guardados en: " << filename << std::endl;
+    } else {
+        std::cerr << "No se pudo abrir el archivo: " << filename << std::endl;
+        return "";
+    }
+
+    return filename;
+}
+
+/**
+ * @brief Genera un gráfico de la solución.
+ *
+ * @param nombreArchivo Nombre del archivo de datos.
+ * @param opcionGrafica Opción de la herramienta de graficación (1: Python/Matplotlib, 2: Gnuplot).
+ */
+void Graficar(const std::string& nombreArchivo, int opcionGrafica) {
+    std::string comando;
+    if (opcionGrafica == 1) {
+        comando = "python scripts/plot_svlaplace.py " + nombreArchivo;
+    } else if (opcionGrafica == 2) {
+        comando = "gnuplot -e \"data_file='" + nombreArchivo + "'\" scripts/plot_svlaplace.gp";
+    } else {
+        std::cerr << "Opción de graficación no válida." << std::endl;
+        return;
+    }
+    std::cout << "Ejecutando: " << comando << std::endl;
+    int resultado = system(comando.c_str());
+    if (resultado != 0) {
+        std::cerr << "Error al graficar. Código de salida: " << resultado << std::endl;
+    }
+}
@@ -0,0 +1,42 @@
+#include "svlaplaceEquation.h"
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Función principal del programa para resolver la ecuación de Laplace por separación de variables.
+ *
+ * @return Código de salida del programa.
+ */
+int main() {
+    double fronteraIzquierda, base, tolerancia;
+    int nx, ny, opcionGrafica;
+
+    // 1. Obtener los datos de entrada del usuario
+    IngresarDatos(fronteraIzquierda, base, nx, ny, tolerancia, opcionGrafica);
+
+    // 2. Verificar los datos ingresados
+    int codigoError = VerificarDatos(fronteraIzquierda, base, nx, ny, tolerancia, opcionGrafica);
+    if (codigoError != 0) {
+        std::cerr << "Error en los datos de entrada. El programa terminará." << std::endl;
+        return codigoError;
+    }
+
+    // 3. Sumar la serie de Fourier
+    std::cout << "Resolviendo la ecuación de Laplace por separación de variables..." << std::endl;
+    std::vector<std::vector<double>> solucion = SolucionSV(fronteraIzquierda, base, nx, ny, tolerancia);
+
+    // 4. Generar el archivo de datos
+    std::cout << "Generando archivo de datos..." << std::endl;
+    std::string nombreArchivo = GenerarDatos(solucion, nx, ny, fronteraIzquierda, base);
+    if (nombreArchivo == "") {
+        std::cerr << "Error al generar el archivo de datos. El programa terminará." << std::endl;
+        return 1;
+    }
+
+    // 5. Graficar la solución
+    std::cout << "Graficando la solución..." << std::endl;
+    Graficar(nombreArchivo, opcionGrafica);
+
+    std::cout << "Programa terminado." << std::endl;
+    return 0;
+}
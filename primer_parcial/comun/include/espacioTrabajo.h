@@ -0,0 +1,83 @@
+/**
+ * @file     espacioTrabajo.h
+ * @brief    Memoria de trabajo reutilizable entre resoluciones: buffers alineados
+ *           que solo crecen y vistas de malla sobre ellos.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-20
+ * @version  1.0.0
+ * @license  MIT
+ */
+
+#ifndef ESPACIO_TRABAJO_H
+#define ESPACIO_TRABAJO_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Vista no propietaria de una malla guardada por filas.
+ *
+ * El elemento (j, i) está en datos[j * paso + i]; paso >= columnas para que cada
+ * fila empiece alineada.
+ */
+struct VistaMalla {
+    double* datos;
+    int filas;
+    int columnas;
+    std::size_t paso;
+
+    double& operator()(int j, int i) { return datos[j * paso + i]; }
+    const double& operator()(int j, int i) const { return datos[j * paso + i]; }
+};
+
+/**
+ * @brief Conjunto de buffers alineados a 64 bytes que se conservan entre resoluciones.
+ *
+ * Cada ranura guarda el buffer más grande pedido hasta el momento, así que una serie de
+ * resoluciones (barridos, animaciones) solo reserva memoria la primera vez y cuando el
+ * problema crece. Las páginas se tocan al reservarlas para no pagar fallos de página
+ * dentro del cálculo. No es seguro compartir un mismo espacio entre hilos.
+ */
+class EspacioTrabajo {
+public:
+    EspacioTrabajo() {}
+    ~EspacioTrabajo();
+
+    EspacioTrabajo(const EspacioTrabajo&) = delete;
+    EspacioTrabajo& operator=(const EspacioTrabajo&) = delete;
+
+    /**
+     * @brief Devuelve un buffer de al menos n doubles para la ranura indicada.
+     *
+     * El contenido es el que dejó el uso anterior (no se inicializa).
+     *
+     * @param ranura Índice del buffer (0, 1, 2, ...).
+     * @param n Número de doubles requeridos.
+     * @return Puntero alineado a 64 bytes.
+     */
+    double* buffer(std::size_t ranura, std::size_t n);
+
+    /**
+     * @brief Devuelve una vista de malla filas x columnas sobre la ranura indicada.
+     *
+     * @param ranura Índice del buffer.
+     * @param filas Número de filas.
+     * @param columnas Número de columnas.
+     * @return La vista (el paso de fila es múltiplo de 8 doubles).
+     */
+    VistaMalla malla(std::size_t ranura, int filas, int columnas);
+
+    /**
+     * @brief Total de bytes reservados por el espacio de trabajo.
+     */
+    std::size_t bytesReservados() const;
+
+private:
+    struct Bloque {
+        double* datos;
+        std::size_t capacidad;
+    };
+    std::vector<Bloque> bloques_;
+};
+
+#endif // ESPACIO_TRABAJO_H
@@ -0,0 +1,123 @@
+/**
+ * @file     pipelineSalida.h
+ * @brief    Etapa asíncrona de salida: cola acotada de tareas (escritura, gráficas)
+ *           que se ejecutan en hilos de fondo mientras el cálculo continúa.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-20
+ * @version  1.0.0
+ * @license  MIT
+ */
+
+#ifndef PIPELINE_SALIDA_H
+#define PIPELINE_SALIDA_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Cola acotada de tareas atendida por hilos de fondo.
+ *
+ * encolar() bloquea cuando la cola está llena, de modo que un productor más rápido
+ * que el disco (o que Gnuplot) no acumula instantáneas sin límite. Con un solo
+ * trabajador las tareas se ejecutan en el orden en que se encolaron.
+ */
+class PipelineSalida {
+public:
+    /**
+     * @brief Arranca los hilos de la etapa.
+     *
+     * @param capacidad Número máximo de tareas en espera.
+     * @param trabajadores Número de hilos que atienden la cola.
+     */
+    explicit PipelineSalida(std::size_t capacidad = 4, int trabajadores = 1);
+
+    /**
+     * @brief Termina las tareas pendientes y detiene los hilos.
+     */
+    ~PipelineSalida();
+
+    PipelineSalida(const PipelineSalida&) = delete;
+    PipelineSalida& operator=(const PipelineSalida&) = delete;
+
+    /**
+     * @brief Agrega una tarea a la cola; bloquea mientras la cola esté llena.
+     *
+     * @param tarea Función a ejecutar en un hilo de fondo.
+     */
+    void encolar(std::function<void()> tarea);
+
+    /**
+     * @brief Bloquea hasta que no queden tareas en cola ni en ejecución.
+     */
+    void esperar();
+
+private:
+    void atender();
+
+    std::size_t capacidad_;
+    std::deque<std::function<void()>> cola_;
+    std::vector<std::thread> hilos_;
+    std::mutex mutex_;
+    std::condition_variable hayTarea_;
+    std::condition_variable hayEspacio_;
+    std::condition_variable vacia_;
+    int enEjecucion_;
+    bool detener_;
+};
+
+/**
+ * @brief Juego fijo de buffers para las instantáneas que viajan por una PipelineSalida.
+ *
+ * tomar() entrega un buffer libre (bloquea si todos están en uso) y la tarea que lo
+ * consume lo devuelve con liberar(). Con tantos buffers como tareas caben en la etapa
+ * (cola + trabajadores + el que se está llenando) el productor no espera, y una vez que
+ * cada buffer alcanzó el tamaño de la malla el barrido ya no reserva memoria.
+ */
+class BuffersSalida {
+public:
+    /**
+     * @brief Crea el juego de buffers.
+     *
+     * @param cantidad Número de buffers; conviene capacidad + trabajadores + 1.
+     */
+    explicit BuffersSalida(std::size_t cantidad);
+
+    BuffersSalida(const BuffersSalida&) = delete;
+    BuffersSalida& operator=(const BuffersSalida&) = delete;
+
+    /**
+     * @brief Toma un buffer libre con al menos n elementos; bloquea si no hay ninguno.
+     *
+     * @param n Número de elementos requeridos.
+     * @return Índice del buffer tomado.
+     */
+    std::size_t tomar(std::size_t n);
+
+    /**
+     * @brief Datos del buffer tomado.
+     *
+     * @param indice Índice devuelto por tomar().
+     * @return Puntero al inicio del buffer.
+     */
+    double* datos(std::size_t indice) { return buffers_[indice].data(); }
+
+    /**
+     * @brief Devuelve un buffer al juego.
+     *
+     * @param indice Índice devuelto por tomar().
+     */
+    void liberar(std::size_t indice);
+
+private:
+    std::vector<std::vector<double>> buffers_;
+    std::vector<std::size_t> libres_;
+    std::mutex mutex_;
+    std::condition_variable hayLibre_;
+};
+
+#endif // PIPELINE_SALIDA_H
@@ -0,0 +1,105 @@
+/**
+ * @file     transformadas.h
+ * @brief    FFT compleja de longitud arbitraria y transformada seno discreta (DST-I),
+ *           compartidas por los solucionadores espectrales de primer_parcial.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-20
+ * @version  1.0.0
+ * @license  MIT
+ */
+
+#ifndef TRANSFORMADAS_H
+#define TRANSFORMADAS_H
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Plan de FFT compleja hacia adelante, X_k = sum_j x_j e^{-2 pi i jk/n}, sin normalizar.
+ *
+ * Usa Cooley-Tukey de base mixta cuando n solo tiene factores primos pequeños
+ * y el algoritmo de Bluestein (convolución con una FFT de potencia de 2) en otro caso.
+ * Cada plan guarda su memoria de trabajo: no se debe compartir entre hilos.
+ */
+class PlanFFT {
+public:
+    /**
+     * @brief Precalcula factores y raíces de la unidad para longitud n.
+     *
+     * @param n Longitud de la transformada (n >= 1).
+     */
+    explicit PlanFFT(int n);
+
+    /**
+     * @brief Longitud de la transformada.
+     */
+    int tamano() const { return n_; }
+
+    /**
+     * @brief Transforma en el lugar un arreglo de n complejos.
+     *
+     * @param datos Arreglo de entrada y salida.
+     */
+    void transformar(std::complex<double>* datos);
+
+private:
+    void recursiva(const std::complex<double>* entrada, int paso,
+                   std::complex<double>* salida, int n, int nivel);
+
+    int n_;
+    std::vector<int> factores_;
+    std::vector<std::complex<double>> raices_;
+    std::vector<std::complex<double>> trabajo_;
+    std::vector<std::complex<double>> temporal_;
+
+    // Bluestein
+    std::unique_ptr<PlanFFT> planPotencia_;
+    std::vector<std::complex<double>> chirp_;
+    std::vector<std::complex<double>> chirpFFT_;
+};
+
+/**
+ * @brief Plan de transformada seno discreta tipo I de longitud n:
+ *        X_k = sum_{j=1}^{n} x_j sin(pi j k / (n + 1)), k = 1..n.
+ *
+ * La DST-I es su propia inversa salvo el factor 2 / (n + 1). Se calcula con una
+ * FFT compleja de longitud 2(n + 1) sobre la extensión impar de los datos.
+ */
+class PlanDST {
+public:
+    /**
+     * @brief Prepara la transformada de longitud n.
+     *
+     * @param n Número de puntos interiores (n >= 1).
+     */
+    explicit PlanDST(int n);
+
+    /**
+     * @brief Longitud de la transformada.
+     */
+    int tamano() const { return n_; }
+
+    /**
+     * @brief Transforma en el lugar un arreglo de n valores reales.
+     *
+     * @param x Arreglo de entrada y salida (índices 0..n-1 corresponden a j = 1..n).
+     */
+    void transformar(double* x);
+
+    /**
+     * @brief Transforma dos arreglos a la vez con una sola FFT compleja
+     *        (uno en la parte real y otro en la imaginaria).
+     *
+     * @param a Primer arreglo de entrada y salida.
+     * @param b Segundo arreglo de entrada y salida.
+     */
+    void transformar(double* a, double* b);
+
+private:
+    int n_;
+    PlanFFT fft_;
+    std::vector<std::complex<double>> buffer_;
+};
+
+#endif // TRANSFORMADAS_H
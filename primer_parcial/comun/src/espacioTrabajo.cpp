@@ -0,0 +1,65 @@
+/**
+ * @file     espacioTrabajo.cpp
+ * @brief    Implementación de los buffers de trabajo reutilizables.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-20
+ * @version  1.0.0
+ * @license  MIT
+ */
+#include "espacioTrabajo.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+
+const std::size_t ALINEACION = 64; // bytes (una línea de caché)
+const std::size_t DOUBLES_POR_LINEA = ALINEACION / sizeof(double);
+
+} // namespace
+
+EspacioTrabajo::~EspacioTrabajo() {
+    for (Bloque& b : bloques_) {
+        std::free(b.datos);
+    }
+}
+
+double* EspacioTrabajo::buffer(std::size_t ranura, std::size_t n) {
+    if (ranura >= bloques_.size()) {
+        bloques_.resize(ranura + 1, Bloque{nullptr, 0});
+    }
+    Bloque& b = bloques_[ranura];
+    if (n > b.capacidad) {
+        std::free(b.datos);
+        b.datos = nullptr;
+        b.capacidad = 0;
+        std::size_t capacidad = (n + DOUBLES_POR_LINEA - 1) / DOUBLES_POR_LINEA * DOUBLES_POR_LINEA;
+        void* p = nullptr;
+        if (posix_memalign(&p, ALINEACION, capacidad * sizeof(double)) != 0) {
+            throw std::bad_alloc();
+        }
+        std::memset(p, 0, capacidad * sizeof(double)); // toca las páginas ahora
+        b.datos = static_cast<double*>(p);
+        b.capacidad = capacidad;
+    }
+    return b.datos;
+}
+
+VistaMalla EspacioTrabajo::malla(std::size_t ranura, int filas, int columnas) {
+    std::size_t paso = (static_cast<std::size_t>(columnas) + DOUBLES_POR_LINEA - 1)
+                       / DOUBLES_POR_LINEA * DOUBLES_POR_LINEA;
+    VistaMalla vista;
+    vista.datos = buffer(ranura, paso * filas);
+    vista.filas = filas;
+    vista.columnas = columnas;
+    vista.paso = paso;
+    return vista;
+}
+
+std::size_t EspacioTrabajo::bytesReservados() const {
+    std::size_t total = 0;
+    for (const Bloque& b : bloques_) {
+        total += b.capacidad * sizeof(double);
+    }
+    return total;
+}
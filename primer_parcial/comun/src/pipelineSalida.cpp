@@ -0,0 +1,103 @@
+/**
+ * @file     pipelineSalida.cpp
+ * @brief    Implementación de la cola acotada de tareas de salida.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-20
+ * @version  1.0.0
+ * @license  MIT
+ */
+#include "pipelineSalida.h"
+#include <exception>
+#include <iostream>
+
+PipelineSalida::PipelineSalida(std::size_t capacidad, int trabajadores)
+    : capacidad_(capacidad > 0 ? capacidad : 1), enEjecucion_(0), detener_(false) {
+    if (trabajadores < 1) trabajadores = 1;
+    for (int h = 0; h < trabajadores; ++h) {
+        hilos_.emplace_back(&PipelineSalida::atender, this);
+    }
+}
+
+PipelineSalida::~PipelineSalida() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        detener_ = true;
+    }
+    hayTarea_.notify_all();
+    for (auto& hilo : hilos_) {
+        hilo.join();
+    }
+}
+
+void PipelineSalida::encolar(std::function<void()> tarea) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    hayEspacio_.wait(lock, [this] { return cola_.size() < capacidad_; });
+    cola_.push_back(std::move(tarea));
+    lock.unlock();
+    hayTarea_.notify_one();
+}
+
+void PipelineSalida::esperar() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    vacia_.wait(lock, [this] { return cola_.empty() && enEjecucion_ == 0; });
+}
+
+void PipelineSalida::atender() {
+    while (true) {
+        std::function<void()> tarea;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            hayTarea_.wait(lock, [this] { return detener_ || !cola_.empty(); });
+            if (cola_.empty()) {
+                return; // detener_ y ya no queda trabajo
+            }
+            tarea = std::move(cola_.front());
+            cola_.pop_front();
+            ++enEjecucion_;
+        }
+        hayEspacio_.notify_one();
+
+        try {
+            tarea();
+        } catch (const std::exception& e) {
+            std::cerr << "Error en la etapa de salida: " << e.what() << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --enEjecucion_;
+            if (cola_.empty() && enEjecucion_ == 0) {
+                vacia_.notify_all();
+            }
+        }
+    }
+}
+
+BuffersSalida::BuffersSalida(std::size_t cantidad)
+    : buffers_(cantidad > 0 ? cantidad : 1) {
+    for (std::size_t b = buffers_.size(); b > 0; --b) {
+        libres_.push_back(b - 1);
+    }
+}
+
+std::size_t BuffersSalida::tomar(std::size_t n) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    hayLibre_.wait(lock, [this] { return !libres_.empty(); });
+    std::size_t indice = libres_.back();
+    libres_.pop_back();
+    lock.unlock();
+
+    // Solo el dueño actual toca el buffer; crece la primera vez y luego se reutiliza
+    if (buffers_[indice].size() < n) {
+        buffers_[indice].resize(n);
+    }
+    return indice;
+}
+
+void BuffersSalida::liberar(std::size_t indice) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        libres_.push_back(indice);
+    }
+    hayLibre_.notify_one();
+}
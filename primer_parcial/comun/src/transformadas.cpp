@@ -0,0 +1,154 @@
+/**
+ * @file     transformadas.cpp
+ * @brief    Implementación de la FFT de base mixta / Bluestein y de la DST-I.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-20
+ * @version  1.0.0
+ * @license  MIT
+ */
+#include "transformadas.h"
+#include <cmath>
+
+namespace {
+
+const double PI = 3.141592653589793;
+const int PRIMO_MAXIMO = 13; // factores mayores usan Bluestein
+
+std::vector<int> factorizar(int n) {
+    std::vector<int> factores;
+    while (n % 4 == 0) { factores.push_back(4); n /= 4; }
+    while (n % 2 == 0) { factores.push_back(2); n /= 2; }
+    for (int p = 3; p * p <= n; p += 2) {
+        while (n % p == 0) { factores.push_back(p); n /= p; }
+    }
+    if (n > 1) factores.push_back(n);
+    return factores;
+}
+
+} // namespace
+
+PlanFFT::PlanFFT(int n) : n_(n) {
+    factores_ = factorizar(n);
+    bool bluestein = false;
+    for (int p : factores_) {
+        if (p > PRIMO_MAXIMO) bluestein = true;
+    }
+
+    if (!bluestein) {
+        raices_.resize(n);
+        for (int k = 0; k < n; ++k) {
+            raices_[k] = std::polar(1.0, -2.0 * PI * k / n);
+        }
+        trabajo_.resize(n);
+        temporal_.resize(PRIMO_MAXIMO);
+        return;
+    }
+
+    // Bluestein: X_k = conj(c_k) sum_j (x_j conj(c_j)) c_{k-j}, c_k = e^{i pi k^2 / n}
+    int m = 1;
+    while (m < 2 * n - 1) m *= 2;
+    planPotencia_.reset(new PlanFFT(m));
+    chirp_.resize(n);
+    for (long long k = 0; k < n; ++k) {
+        long long k2 = (k * k) % (2LL * n); // reduce el argumento para no perder precisión
+        chirp_[k] = std::polar(1.0, PI * k2 / n);
+    }
+    chirpFFT_.assign(m, 0.0);
+    chirpFFT_[0] = chirp_[0];
+    for (int k = 1; k < n; ++k) {
+        chirpFFT_[k] = chirpFFT_[m - k] = chirp_[k];
+    }
+    planPotencia_->transformar(chirpFFT_.data());
+    trabajo_.resize(m);
+}
+
+void PlanFFT::recursiva(const std::complex<double>* entrada, int paso,
+                        std::complex<double>* salida, int n, int nivel) {
+    if (n == 1) {
+        salida[0] = entrada[0];
+        return;
+    }
+    int p = factores_[nivel];
+    int m = n / p;
+    for (int r = 0; r < p; ++r) {
+        recursiva(entrada + r * paso, paso * p, salida + r * m, m, nivel + 1);
+    }
+
+    // Mariposas de base p: salida[q*m + k] = sum_r W_n^{r(k + q m)} salida[r*m + k]
+    int escala = n_ / n;       // W_n^t = raices_[t * escala]
+    int escalaP = n_ / p;      // W_p^t = raices_[t * escalaP]
+    std::complex<double>* t = temporal_.data();
+    for (int k = 0; k < m; ++k) {
+        for (int r = 0; r < p; ++r) {
+            t[r] = salida[r * m + k] * raices_[(r * k * escala) % n_];
+        }
+        if (p == 2) {
+            salida[k] = t[0] + t[1];
+            salida[m + k] = t[0] - t[1];
+        } else if (p == 4) {
+            std::complex<double> a = t[0] + t[2], b = t[0] - t[2];
+            std::complex<double> c = t[1] + t[3];
+            std::complex<double> d = (t[1] - t[3]) * std::complex<double>(0.0, -1.0);
+            salida[k] = a + c;
+            salida[m + k] = b + d;
+            salida[2 * m + k] = a - c;
+            salida[3 * m + k] = b - d;
+        } else {
+            for (int q = 0; q < p; ++q) {
+                std::complex<double> suma = t[0];
+                for (int r = 1; r < p; ++r) {
+                    suma += t[r] * raices_[((r * q) % p) * escalaP];
+                }
+                salida[q * m + k] = suma;
+            }
+        }
+    }
+}
+
+void PlanFFT::transformar(std::complex<double>* datos) {
+    if (!planPotencia_) {
+        recursiva(datos, 1, trabajo_.data(), n_, 0);
+        std::copy(trabajo_.begin(), trabajo_.end(), datos);
+        return;
+    }
+
+    int m = planPotencia_->tamano();
+    for (int k = 0; k < n_; ++k) trabajo_[k] = datos[k] * std::conj(chirp_[k]);
+    std::fill(trabajo_.begin() + n_, trabajo_.end(), 0.0);
+    planPotencia_->transformar(trabajo_.data());
+    // Convolución circular y FFT inversa como conj(FFT(conj(.))) / m
+    for (int k = 0; k < m; ++k) trabajo_[k] = std::conj(trabajo_[k] * chirpFFT_[k]);
+    planPotencia_->transformar(trabajo_.data());
+    for (int k = 0; k < n_; ++k) {
+        datos[k] = std::conj(trabajo_[k]) * std::conj(chirp_[k]) / static_cast<double>(m);
+    }
+}
+
+PlanDST::PlanDST(int n) : n_(n), fft_(2 * (n + 1)), buffer_(2 * (n + 1)) {}
+
+void PlanDST::transformar(double* x) {
+    // Extensión impar [0, x, 0, -x invertido]: FFT = -2i X
+    int m = 2 * (n_ + 1);
+    buffer_[0] = buffer_[n_ + 1] = 0.0;
+    for (int j = 0; j < n_; ++j) {
+        buffer_[j + 1] = x[j];
+        buffer_[m - 1 - j] = -x[j];
+    }
+    fft_.transformar(buffer_.data());
+    for (int k = 0; k < n_; ++k) x[k] = -0.5 * buffer_[k + 1].imag();
+}
+
+void PlanDST::transformar(double* a, double* b) {
+    // FFT(ext(a) + i ext(b)) = -2i A + 2 B con A y B reales
+    int m = 2 * (n_ + 1);
+    buffer_[0] = buffer_[n_ + 1] = 0.0;
+    for (int j = 0; j < n_; ++j) {
+        buffer_[j + 1] = std::complex<double>(a[j], b[j]);
+        buffer_[m - 1 - j] = std::complex<double>(-a[j], -b[j]);
+    }
+    fft_.transformar(buffer_.data());
+    for (int k = 0; k < n_; ++k) {
+        a[k] = -0.5 * buffer_[k + 1].imag();
+        b[k] = 0.5 * buffer_[k + 1].real();
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ * @file     cacheLRU.h
+ * @brief    Caché acotada con desalojo del elemento usado hace más tiempo.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-24
+ * @version  1.0.0
+ * @license  MIT
+ */
+
+#ifndef CACHE_LRU_H
+#define CACHE_LRU_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Caché de hasta 'capacidad' valores compartidos, indexada por texto.
+ *
+ * Los valores se guardan como shared_ptr: un elemento desalojado sigue vivo mientras
+ * algún trabajo lo esté usando. Es segura entre hilos.
+ */
+template <typename Valor>
+class CacheLRU {
+public:
+    explicit CacheLRU(std::size_t capacidad) : capacidad_(capacidad > 0 ? capacidad : 1) {}
+
+    /**
+     * @brief Busca la clave y la marca como usada recientemente.
+     *
+     * @return El valor, o nullptr si no está.
+     */
+    std::shared_ptr<Valor> buscar(const std::string& clave) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = indice_.find(clave);
+        if (it == indice_.end()) {
+            ++fallos_;
+            return nullptr;
+        }
+        ++aciertos_;
+        orden_.splice(orden_.begin(), orden_, it->second);
+        return it->second->second;
+    }
+
+    /**
+     * @brief Devuelve el valor de la clave y, si no está, lo crea con crear() y lo guarda.
+     *
+     * La creación ocurre con la caché bloqueada: debe ser barata (por ejemplo, una entrada
+     * vacía que el llamador completa después bajo su propio mutex).
+     */
+    template <typename Fabrica>
+    std::shared_ptr<Valor> obtener(const std::string& clave, Fabrica crear) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = indice_.find(clave);
+        if (it != indice_.end()) {
+            ++aciertos_;
+            orden_.splice(orden_.begin(), orden_, it->second);
+            return it->second->second;
+        }
+        ++fallos_;
+        std::shared_ptr<Valor> valor = crear();
+        insertar(clave, valor);
+        return valor;
+    }
+
+    /**
+     * @brief Guarda el valor (o lo reemplaza) y desaloja el más antiguo si hace falta.
+     */
+    void guardar(const std::string& clave, std::shared_ptr<Valor> valor) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = indice_.find(clave);
+        if (it != indice_.end()) {
+            it->second->second = std::move(valor);
+            orden_.splice(orden_.begin(), orden_, it->second);
+            return;
+        }
+        insertar(clave, std::move(valor));
+    }
+
+    /**
+     * @brief Número de elementos, aciertos y fallos hasta el momento.
+     */
+    void estadisticas(std::size_t& elementos, std::size_t& aciertos, std::size_t& fallos) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        elementos = orden_.size();
+        aciertos = aciertos_;
+        fallos = fallos_;
+    }
+
+private:
+    using Entrada = std::pair<std::string, std::shared_ptr<Valor>>;
+
+    void insertar(const std::string& clave, std::shared_ptr<Valor> valor) {
+        orden_.emplace_front(clave, std::move(valor));
+        indice_[clave] = orden_.begin();
+        if (orden_.size() > capacidad_) {
+            indice_.erase(orden_.back().first);
+            orden_.pop_back();
+        }
+    }
+
+    std::size_t capacidad_;
+    std::list<Entrada> orden_;
+    std::unordered_map<std::string, typename std::list<Entrada>::iterator> indice_;
+    std::size_t aciertos_ = 0;
+    std::size_t fallos_ = 0;
+    std::mutex mutex_;
+};
+
+#endif // CACHE_LRU_H
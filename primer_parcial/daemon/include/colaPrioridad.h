@@ -0,0 +1,85 @@
+/**
+ * @file     colaPrioridad.h
+ * @brief    Grupo de hilos compartido que atiende tareas por prioridad.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-24
+ * @version  1.0.0
+ * @license  MIT
+ */
+
+#ifndef COLA_PRIORIDAD_H
+#define COLA_PRIORIDAD_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Grupo de hilos con una cola de prioridad.
+ *
+ * Las tareas de mayor prioridad salen primero; a igual prioridad se respeta el orden de
+ * llegada. A diferencia de PipelineSalida, la cola no está acotada: quien encola es el
+ * lector de una conexión y no debe bloquearse mientras los hilos están ocupados.
+ */
+class GrupoHilosPrioridad {
+public:
+    /**
+     * @brief Arranca los hilos.
+     *
+     * @param trabajadores Número de hilos (al menos 1).
+     */
+    explicit GrupoHilosPrioridad(int trabajadores);
+
+    /**
+     * @brief Termina las tareas pendientes y detiene los hilos.
+     */
+    ~GrupoHilosPrioridad();
+
+    GrupoHilosPrioridad(const GrupoHilosPrioridad&) = delete;
+    GrupoHilosPrioridad& operator=(const GrupoHilosPrioridad&) = delete;
+
+    /**
+     * @brief Agrega una tarea.
+     *
+     * @param prioridad Mayor valor, antes se atiende.
+     * @param tarea Función a ejecutar en uno de los hilos.
+     */
+    void encolar(int prioridad, std::function<void()> tarea);
+
+    /**
+     * @brief Número de tareas en espera (sin contar las que están en ejecución).
+     */
+    std::size_t pendientes();
+
+    /**
+     * @brief Número de hilos del grupo.
+     */
+    int trabajadores() const { return static_cast<int>(hilos_.size()); }
+
+private:
+    struct Tarea {
+        int prioridad;
+        std::uint64_t orden;
+        std::function<void()> funcion;
+
+        bool operator<(const Tarea& otra) const {
+            if (prioridad != otra.prioridad) return prioridad < otra.prioridad;
+            return orden > otra.orden;
+        }
+    };
+
+    void atender();
+
+    std::priority_queue<Tarea> cola_;
+    std::vector<std::thread> hilos_;
+    std::mutex mutex_;
+    std::condition_variable hayTarea_;
+    std::uint64_t siguiente_;
+    bool detener_;
+};
+
+#endif // COLA_PRIORIDAD_H
@@ -0,0 +1,66 @@
+/**
+ * @file     json.h
+ * @brief    Lector mínimo de JSON para los trabajos del servicio y utilidades de escritura.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-24
+ * @version  1.0.0
+ * @license  MIT
+ */
+
+#ifndef JSON_H
+#define JSON_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Valor JSON: nulo, booleano, número, texto, lista u objeto.
+ */
+struct ValorJSON {
+    enum Tipo { NULO, BOOLEANO, NUMERO, TEXTO, LISTA, OBJETO };
+
+    Tipo tipo = NULO;
+    bool booleano = false;
+    double numero = 0.0;
+    std::string texto;
+    std::vector<ValorJSON> lista;
+    std::map<std::string, ValorJSON> objeto;
+
+    /**
+     * @brief Devuelve el miembro 'clave' de un objeto, o nullptr si no existe.
+     */
+    const ValorJSON* miembro(const std::string& clave) const;
+
+    /**
+     * @brief Número del miembro 'clave', o 'defecto' si no existe o no es un número.
+     */
+    double numeroO(const std::string& clave, double defecto) const;
+
+    /**
+     * @brief Texto del miembro 'clave', o 'defecto' si no existe o no es texto.
+     */
+    std::string textoO(const std::string& clave, const std::string& defecto) const;
+};
+
+/**
+ * @brief Interpreta un documento JSON completo.
+ *
+ * @param texto Documento (una línea del protocolo).
+ * @param valor Valor leído.
+ * @param error Descripción del error si el documento no es válido.
+ * @return true si el documento es válido.
+ */
+bool LeerJSON(const std::string& texto, ValorJSON& valor, std::string& error);
+
+/**
+ * @brief Agrega un número con 17 cifras significativas (ida y vuelta exacta).
+ */
+void EscribirNumero(std::string& salida, double x);
+
+/**
+ * @brief Agrega un texto entre comillas con los caracteres especiales escapados.
+ */
+void EscribirTexto(std::string& salida, const std::string& texto);
+
+#endif // JSON_H
@@ -0,0 +1,128 @@
+/**
+ * @file     servidor.h
+ * @brief    Servicio local de larga duración: recibe trabajos JSON por un socket Unix,
+ *           los resuelve en un grupo de hilos con prioridades y devuelve los resultados
+ *           por partes, con factorizaciones y soluciones recientes en memoria.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-24
+ * @version  1.0.0
+ * @license  MIT
+ */
+
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cacheLRU.h"
+#include "colaPrioridad.h"
+#include "json.h"
+
+class SolucionadorCapacitancia;
+class PropagadorEspectral;
+
+/**
+ * @brief Servidor de trabajos sobre un socket Unix.
+ *
+ * Un solo hilo atiende el socket con poll(): acepta conexiones, separa las líneas y
+ * encola cada trabajo en el grupo de hilos. Las respuestas las escriben los hilos del
+ * grupo, una línea JSON (o un bloque binario) a la vez, así que varios trabajos de una
+ * misma conexión pueden intercalarse; cada mensaje lleva el "id" de su trabajo. Los
+ * sockets no bloquean: lo que un cliente no alcanza a leer queda en la cola de salida de
+ * su conexión y lo envía el hilo de poll().
+ */
+class ServidorSolver {
+public:
+    /**
+     * @brief Prepara el servidor.
+     *
+     * @param ruta Ruta del socket Unix.
+     * @param trabajadores Número de hilos que resuelven trabajos.
+     */
+    ServidorSolver(const std::string& ruta, int trabajadores);
+
+    /**
+     * @brief Cierra el socket, termina los trabajos pendientes y borra el archivo del socket.
+     */
+    ~ServidorSolver();
+
+    ServidorSolver(const ServidorSolver&) = delete;
+    ServidorSolver& operator=(const ServidorSolver&) = delete;
+
+    /**
+     * @brief Crea el socket y empieza a escuchar.
+     *
+     * @param error Descripción del error si no se pudo.
+     * @return true si el socket quedó escuchando.
+     */
+    bool iniciar(std::string& error);
+
+    /**
+     * @brief Atiende conexiones hasta que se pida apagar el servidor.
+     */
+    void atender();
+
+    /**
+     * @brief Pide al bucle de atender() que termine; se puede llamar desde un manejador de señales.
+     */
+    void apagar();
+
+private:
+    struct Conexion;
+
+    /**
+     * @brief Solución guardada en la caché: matriz filas x columnas por filas.
+     */
+    struct Resultado {
+        std::vector<double> datos;
+        int filas;
+        int columnas;
+    };
+
+    /**
+     * @brief Solucionador directo factorizado; el mutex lo protege porque guarda buffers internos.
+     */
+    struct DirectoEnCache {
+        std::mutex mutex;
+        std::unique_ptr<SolucionadorCapacitancia> solucionador;
+    };
+
+    /**
+     * @brief Propagador espectral con las condiciones iniciales ya proyectadas.
+     */
+    struct PropagadorEnCache {
+        std::mutex mutex;
+        std::unique_ptr<PropagadorEspectral> propagador;
+    };
+
+    using Reloj = std::chrono::steady_clock;
+
+    void procesarLinea(const std::shared_ptr<Conexion>& conexion, const std::string& linea);
+    void trabajoLaplace(Conexion& conexion, const ValorJSON& trabajo, Reloj::time_point llegada);
+    void trabajoOnda(Conexion& conexion, const ValorJSON& trabajo, Reloj::time_point llegada);
+    std::string estado();
+
+    void enviarResultado(Conexion& conexion, const std::string& id, const char* tipo,
+                         const Resultado& resultado, const std::string& extra, bool binario);
+    void enviarError(Conexion& conexion, const std::string& id, const std::string& mensaje);
+
+    std::string ruta_;
+    int socket_;
+    int despertar_[2];
+    std::atomic<bool> activo_;
+    CacheLRU<const Resultado> soluciones_;
+    CacheLRU<DirectoEnCache> directos_;
+    CacheLRU<PropagadorEnCache> propagadores_;
+    std::atomic<std::uint64_t> recibidos_;
+    std::atomic<std::uint64_t> terminados_;
+    // Último miembro: se destruye primero y termina los trabajos que aún usan las cachés
+    GrupoHilosPrioridad grupo_;
+};
+
+#endif // SERVIDOR_H
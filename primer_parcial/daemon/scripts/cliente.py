@@ -0,0 +1,64 @@
+"""Cliente mínimo de solverd: envía trabajos y mide la latencia de ida y vuelta.
+
+Uso: python scripts/cliente.py [ruta del socket] [repeticiones]
+"""
+import json
+import socket
+import struct
+import sys
+import time
+
+ruta = sys.argv[1] if len(sys.argv) > 1 else "/tmp/solverd.sock"
+repeticiones = int(sys.argv[2]) if len(sys.argv) > 2 else 200
+
+
+class Cliente:
+    def __init__(self, ruta):
+        self.socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.socket.connect(ruta)
+        self.archivo = self.socket.makefile("rb")
+        self.siguiente = 0
+
+    def trabajo(self, **campos):
+        """Envía un trabajo y devuelve sus mensajes hasta "fin" (o "error")."""
+        self.siguiente += 1
+        campos["id"] = self.siguiente
+        self.socket.sendall((json.dumps(campos) + "\n").encode())
+        mensajes = []
+        while True:
+            mensaje = json.loads(self.archivo.readline())
+            if "bytes" in mensaje:
+                crudo = self.archivo.read(mensaje["bytes"])
+                mensaje["datos"] = list(struct.unpack("%dd" % (len(crudo) // 8), crudo))
+            mensajes.append(mensaje)
+            if mensaje["tipo"] in ("fin", "error", "estado"):
+                return mensajes
+
+
+def latencia(cliente, repeticiones, **campos):
+    inicio = time.perf_counter()
+    for _ in range(repeticiones):
+        cliente.trabajo(**campos)
+    return (time.perf_counter() - inicio) / repeticiones * 1e6
+
+
+cliente = Cliente(ruta)
+escalera = dict(tipo="laplace", fronteraIzquierda=100.0, base=50.0, escalera=80.0, nx=60, ny=60)
+
+primera = cliente.trabajo(opcionImplementacion=3, **escalera)
+print("laplace directo, primera vez: %d us en el servidor" % primera[0]["microsegundos"])
+print("laplace directo, repetido:    %.1f us ida y vuelta" %
+      latencia(cliente, repeticiones, opcionImplementacion=3, formato="binario", **escalera))
+
+otra = dict(escalera, base=20.0)
+cliente.trabajo(opcionImplementacion=3, **otra)
+print("laplace directo, otra frontera con la factorización en caché: %d us en el servidor" %
+      cliente.trabajo(opcionImplementacion=3, formato="binario", **dict(otra, escalera=10.0))[0]["microsegundos"])
+
+onda = cliente.trabajo(tipo="onda", tiempos=[0.0, 0.5, 1.0, 1.5])
+print("onda espectral: %d fotogramas" % (len(onda) - 1))
+print("onda espectral, repetido: %.1f us ida y vuelta" % latencia(cliente, repeticiones, tipo="onda", t=0.75))
+print("onda fdm (en caché):      %.1f us ida y vuelta" %
+      latencia(cliente, repeticiones, tipo="onda", metodo="fdm", t=0.75))
+
+print(json.dumps(cliente.trabajo(tipo="estado")[0], indent=1))
@@ -0,0 +1,63 @@
+/**
+ * @file     colaPrioridad.cpp
+ * @brief    Implementación del grupo de hilos con prioridades.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-24
+ * @version  1.0.0
+ * @license  MIT
+ */
+#include "colaPrioridad.h"
+#include <exception>
+#include <iostream>
+
+GrupoHilosPrioridad::GrupoHilosPrioridad(int trabajadores) : siguiente_(0), detener_(false) {
+    if (trabajadores < 1) trabajadores = 1;
+    for (int h = 0; h < trabajadores; ++h) {
+        hilos_.emplace_back(&GrupoHilosPrioridad::atender, this);
+    }
+}
+
+GrupoHilosPrioridad::~GrupoHilosPrioridad() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        detener_ = true;
+    }
+    hayTarea_.notify_all();
+    for (auto& hilo : hilos_) {
+        hilo.join();
+    }
+}
+
+void GrupoHilosPrioridad::encolar(int prioridad, std::function<void()> tarea) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cola_.push(Tarea{prioridad, siguiente_++, std::move(tarea)});
+    }
+    hayTarea_.notify_one();
+}
+
+std::size_t GrupoHilosPrioridad::pendientes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cola_.size();
+}
+
+void GrupoHilosPrioridad::atender() {
+    while (true) {
+        std::function<void()> tarea;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            hayTarea_.wait(lock, [this] { return detener_ || !cola_.empty(); });
+            if (cola_.empty()) {
+                return; // detener_ y ya no queda trabajo
+            }
+            tarea = std::move(const_cast<Tarea&>(cola_.top()).funcion);
+            cola_.pop();
+        }
+
+        try {
+            tarea();
+        } catch (const std::exception& e) {
+            std::cerr << "Error en una tarea del servicio: " << e.what() << std::endl;
+        }
+    }
+}
@@ -0,0 +1,221 @@
+/**
+ * @file     json.cpp
+ * @brief    Implementación del lector mínimo de JSON.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-24
+ * @version  1.0.0
+ * @license  MIT
+ */
+#include "json.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+const ValorJSON* ValorJSON::miembro(const std::string& clave) const {
+    if (tipo != OBJETO) return nullptr;
+    auto it = objeto.find(clave);
+    return it == objeto.end() ? nullptr : &it->second;
+}
+
+double ValorJSON::numeroO(const std::string& clave, double defecto) const {
+    const ValorJSON* v = miembro(clave);
+    return (v != nullptr && v->tipo == NUMERO) ? v->numero : defecto;
+}
+
+std::string ValorJSON::textoO(const std::string& clave, const std::string& defecto) const {
+    const ValorJSON* v = miembro(clave);
+    return (v != nullptr && v->tipo == TEXTO) ? v->texto : defecto;
+}
+
+namespace {
+
+/**
+ * @brief Lector recursivo descendente sobre el texto completo.
+ */
+class Lector {
+public:
+    explicit Lector(const std::string& texto) : s_(texto), pos_(0) {}
+
+    bool documento(ValorJSON& valor, std::string& error) {
+        if (!leerValor(valor, 0)) {
+            error = error_;
+            return false;
+        }
+        espacios();
+        if (pos_ != s_.size()) {
+            error = "caracteres sobrantes en la posición " + std::to_string(pos_);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static const int PROFUNDIDAD_MAXIMA = 32;
+
+    bool fallar(const std::string& mensaje) {
+        error_ = mensaje + " en la posición " + std::to_string(pos_);
+        return false;
+    }
+
+    void espacios() {
+        while (pos_ < s_.size() && (s_[pos_] == ' ' || s_[pos_] == '\t' || s_[pos_] == '\n' || s_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    bool literal(const char* palabra) {
+        std::size_t n = std::char_traits<char>::length(palabra);
+        if (s_.compare(pos_, n, palabra) != 0) return false;
+        pos_ += n;
+        return true;
+    }
+
+    bool leerValor(ValorJSON& v, int profundidad) {
+        if (profundidad > PROFUNDIDAD_MAXIMA) return fallar("anidamiento excesivo");
+        espacios();
+        if (pos_ >= s_.size()) return fallar("fin inesperado");
+        char ch = s_[pos_];
+        if (ch == '{') return leerObjeto(v, profundidad);
+        if (ch == '[') return leerLista(v, profundidad);
+        if (ch == '"') {
+            v.tipo = ValorJSON::TEXTO;
+            return leerTexto(v.texto);
+        }
+        if (literal("true")) { v.tipo = ValorJSON::BOOLEANO; v.booleano = true; return true; }
+        if (literal("false")) { v.tipo = ValorJSON::BOOLEANO; v.booleano = false; return true; }
+        if (literal("null")) { v.tipo = ValorJSON::NULO; return true; }
+        return leerNumero(v);
+    }
+
+    bool leerNumero(ValorJSON& v) {
+        const char* inicio = s_.c_str() + pos_;
+        char* fin = nullptr;
+        double x = std::strtod(inicio, &fin);
+        if (fin == inicio || !std::isfinite(x)) return fallar("valor no válido");
+        pos_ += fin - inicio;
+        v.tipo = ValorJSON::NUMERO;
+        v.numero = x;
+        return true;
+    }
+
+    bool leerTexto(std::string& t) {
+        ++pos_; // comilla inicial
+        t.clear();
+        while (pos_ < s_.size()) {
+            char ch = s_[pos_++];
+            if (ch == '"') return true;
+            if (ch != '\\') {
+                t += ch;
+                continue;
+            }
+            if (pos_ >= s_.size()) break;
+            char esc = s_[pos_++];
+            switch (esc) {
+                case '"': t += '"'; break;
+                case '\\': t += '\\'; break;
+                case '/': t += '/'; break;
+                case 'b': t += '\b'; break;
+                case 'f': t += '\f'; break;
+                case 'n': t += '\n'; break;
+                case 'r': t += '\r'; break;
+                case 't': t += '\t'; break;
+                case 'u': {
+                    if (pos_ + 4 > s_.size()) return fallar("escape \\u incompleto");
+                    unsigned codigo = std::strtoul(s_.substr(pos_, 4).c_str(), nullptr, 16);
+                    pos_ += 4;
+                    // UTF-8 del plano básico (sin pares sustitutos)
+                    if (codigo < 0x80) {
+                        t += static_cast<char>(codigo);
+                    } else if (codigo < 0x800) {
+                        t += static_cast<char>(0xC0 | (codigo >> 6));
+                        t += static_cast<char>(0x80 | (codigo & 0x3F));
+                    } else {
+                        t += static_cast<char>(0xE0 | (codigo >> 12));
+                        t += static_cast<char>(0x80 | ((codigo >> 6) & 0x3F));
+                        t += static_cast<char>(0x80 | (codigo & 0x3F));
+                    }
+                    break;
+                }
+                default: return fallar("escape no válido");
+            }
+        }
+        return fallar("texto sin cerrar");
+    }
+
+    bool leerLista(ValorJSON& v, int profundidad) {
+        ++pos_;
+        v.tipo = ValorJSON::LISTA;
+        espacios();
+        if (pos_ < s_.size() && s_[pos_] == ']') { ++pos_; return true; }
+        while (true) {
+            v.lista.emplace_back();
+            if (!leerValor(v.lista.back(), profundidad + 1)) return false;
+            espacios();
+            if (pos_ >= s_.size()) return fallar("lista sin cerrar");
+            if (s_[pos_] == ',') { ++pos_; continue; }
+            if (s_[pos_] == ']') { ++pos_; return true; }
+            return fallar("se esperaba ',' o ']'");
+        }
+    }
+
+    bool leerObjeto(ValorJSON& v, int profundidad) {
+        ++pos_;
+        v.tipo = ValorJSON::OBJETO;
+        espacios();
+        if (pos_ < s_.size() && s_[pos_] == '}') { ++pos_; return true; }
+        while (true) {
+            espacios();
+            if (pos_ >= s_.size() || s_[pos_] != '"') return fallar("se esperaba una clave");
+            std::string clave;
+            if (!leerTexto(clave)) return false;
+            espacios();
+            if (pos_ >= s_.size() || s_[pos_] != ':') return fallar("se esperaba ':'");
+            ++pos_;
+            if (!leerValor(v.objeto[clave], profundidad + 1)) return false;
+            espacios();
+            if (pos_ >= s_.size()) return fallar("objeto sin cerrar");
+            if (s_[pos_] == ',') { ++pos_; continue; }
+            if (s_[pos_] == '}') { ++pos_; return true; }
+            return fallar("se esperaba ',' o '}'");
+        }
+    }
+
+    const std::string& s_;
+    std::size_t pos_;
+    std::string error_;
+};
+
+} // namespace
+
+bool LeerJSON(const std::string& texto, ValorJSON& valor, std::string& error) {
+    valor = ValorJSON();
+    return Lector(texto).documento(valor, error);
+}
+
+void EscribirNumero(std::string& salida, double x) {
+    char buffer[32];
+    int n = std::snprintf(buffer, sizeof(buffer), "%.17g", x);
+    salida.append(buffer, n);
+}
+
+void EscribirTexto(std::string& salida, const std::string& texto) {
+    salida += '"';
+    for (char ch : texto) {
+        switch (ch) {
+            case '"': salida += "\\\""; break;
+            case '\\': salida += "\\\\"; break;
+            case '\n': salida += "\\n"; break;
+            case '\r': salida += "\\r"; break;
+            case '\t': salida += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+                    salida += buffer;
+                } else {
+                    salida += ch;
+                }
+        }
+    }
+    salida += '"';
+}
@@ -0,0 +1,742 @@
+/**
+ * @file     servidor.cpp
+ * @brief    Implementación del servicio de trabajos sobre un socket Unix.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-24
+ * @version  1.0.0
+ * @license  MIT
+ */
+#include "servidor.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <map>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "capacitancia.h"
+#include "laplaceEquation.h"
+#include "waveEquation.h"
+
+namespace {
+
+const std::size_t SOLUCIONES_EN_CACHE = 64;    // mallas y fotogramas recientes
+const std::size_t DIRECTOS_EN_CACHE = 8;       // factorizaciones de capacitancia
+const std::size_t PROPAGADORES_EN_CACHE = 16;  // condiciones iniciales proyectadas
+const std::size_t LINEA_MAXIMA = 256u << 20;   // bytes de un trabajo sin salto de línea
+const std::size_t SALIDA_MAXIMA = 256u << 20;  // bytes en cola para un cliente que no lee
+const std::chrono::seconds SALIDA_ESPERA_MAXIMA(30);  // sin aceptar bytes, se cierra la conexión
+const int FILAS_POR_MENSAJE = 32;              // filas de una malla por línea JSON
+const int PRIORIDAD_MAXIMA = 1000;             // |prioridad| de un trabajo
+const int MALLA_MAXIMA = 2048;                 // nx, ny con las opciones 1 y 2
+const int MALLA_DIRECTA_MAXIMA = 1024;         // nx, ny con la opción 3 (factorización densa O(n³))
+const std::size_t TIEMPOS_MAXIMOS = 4096;      // fotogramas de un trabajo de onda
+
+/**
+ * @brief El "id" del trabajo tal como se devuelve en cada mensaje.
+ */
+std::string TextoId(const ValorJSON& trabajo) {
+    std::string id;
+    const ValorJSON* v = trabajo.miembro("id");
+    if (v != nullptr && v->tipo == ValorJSON::NUMERO) {
+        EscribirNumero(id, v->numero);
+    } else if (v != nullptr && v->tipo == ValorJSON::TEXTO) {
+        EscribirTexto(id, v->texto);
+    } else {
+        id = "null";
+    }
+    return id;
+}
+
+/**
+ * @brief Copia una lista JSON de números; false si no es una lista de n números finitos.
+ */
+bool ListaNumeros(const ValorJSON* v, std::size_t n, std::vector<double>& valores) {
+    if (v == nullptr || v->tipo != ValorJSON::LISTA || v->lista.size() != n) return false;
+    valores.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (v->lista[i].tipo != ValorJSON::NUMERO || !std::isfinite(v->lista[i].numero)) return false;
+        valores[i] = v->lista[i].numero;
+    }
+    return true;
+}
+
+/**
+ * @brief Lee un entero del trabajo sin convertir valores que no caben en un int.
+ *
+ * El miembro debe ser un número finito, sin parte fraccionaria y dentro de [minimo, maximo];
+ * si no existe se usa 'defecto'.
+ *
+ * @return false, con el motivo en 'error', si el valor no cumple.
+ */
+bool LeerEntero(const ValorJSON& trabajo, const char* clave, int defecto, int minimo, int maximo,
+                int& valor, std::string& error) {
+    const ValorJSON* v = trabajo.miembro(clave);
+    if (v == nullptr) {
+        valor = defecto;
+        return true;
+    }
+    if (v->tipo != ValorJSON::NUMERO || !std::isfinite(v->numero) || v->numero != std::floor(v->numero) ||
+        v->numero < minimo || v->numero > maximo) {
+        error = std::string(clave) + " debe ser un entero entre " + std::to_string(minimo) +
+                " y " + std::to_string(maximo);
+        return false;
+    }
+    valor = static_cast<int>(v->numero);
+    return true;
+}
+
+/**
+ * @brief Clave exacta de un double (sus bytes), para que la caché no confunda valores cercanos.
+ */
+void AgregarClave(std::string& clave, double x) {
+    clave.append(reinterpret_cast<const char*>(&x), sizeof(x));
+}
+
+} // namespace
+
+/**
+ * @brief Conexión de un cliente: el hilo de poll() lee y los hilos del grupo escriben.
+ *
+ * Nadie se bloquea en send(): lo que el socket no acepta queda en la cola de salida y lo
+ * termina de enviar el hilo de poll() cuando el socket vuelve a aceptar bytes.
+ */
+struct ServidorSolver::Conexion {
+    int fd;
+    int despertar;  // extremo de escritura de la tubería que despierta a poll()
+    std::mutex escritura;
+    bool rota = false;
+    std::string salida;            // con el mutex: bytes pendientes desde 'enviados'
+    std::size_t enviados = 0;
+    Reloj::time_point ultimoAvance;
+    std::atomic<int> trabajos{0};  // trabajos encolados o en curso
+    bool leyendo = true;           // solo lo tocan el hilo de poll()
+    std::string entrada;           // y este buffer
+
+    Conexion(int f, int d) : fd(f), despertar(d) {}
+    ~Conexion() { close(fd); }
+
+    /**
+     * @brief Despierta al hilo de poll() para que revise la conexión.
+     */
+    void avisar() {
+        ssize_t ignorado = write(despertar, "x", 1);
+        (void)ignorado;
+    }
+
+    std::size_t pendiente() const { return salida.size() - enviados; }
+
+    /**
+     * @brief Descarta la salida: el cliente se fue o dejó de leer.
+     */
+    void descartar() {
+        rota = true;
+        std::string().swap(salida);
+        enviados = 0;
+    }
+
+    /**
+     * @brief Envía sin bloquear; devuelve los bytes que aceptó el socket.
+     */
+    std::size_t enviar(const char* datos, std::size_t n) {
+        std::size_t total = 0;
+        while (total < n) {
+            ssize_t escritos = send(fd, datos + total, n - total, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (escritos < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) descartar();
+                break;
+            }
+            total += static_cast<std::size_t>(escritos);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Envía lo que se pueda y encola el resto; con el mutex de escritura tomado por el llamador.
+     */
+    void escribir(const char* datos, std::size_t n) {
+        if (rota || n == 0) return;
+        bool estabaVacia = pendiente() == 0;
+        if (estabaVacia) {
+            std::size_t aceptados = enviar(datos, n);
+            if (rota || aceptados == n) return;
+            datos += aceptados;
+            n -= aceptados;
+            ultimoAvance = Reloj::now();
+        }
+        if (pendiente() + n > SALIDA_MAXIMA) {
+            descartar();
+            return;
+        }
+        salida.append(datos, n);
+        if (estabaVacia) avisar();
+    }
+
+    /**
+     * @brief Envía lo que se pueda de la cola; lo llama el hilo de poll() con el mutex tomado.
+     */
+    void vaciar() {
+        if (rota || pendiente() == 0) return;
+        std::size_t aceptados = enviar(salida.data() + enviados, pendiente());
+        if (rota || aceptados == 0) return;
+        enviados += aceptados;
+        ultimoAvance = Reloj::now();
+        if (enviados == salida.size()) {
+            salida.clear();
+            enviados = 0;
+        } else if (enviados > salida.size() / 2) {
+            salida.erase(0, enviados);  // compacta sin mover la cola en cada envío
+            enviados = 0;
+        }
+    }
+
+    void enviarLinea(const std::string& linea) {
+        std::lock_guard<std::mutex> lock(escritura);
+        escribir(linea.data(), linea.size());
+    }
+
+    bool descartada() {
+        std::lock_guard<std::mutex> lock(escritura);
+        return rota;
+    }
+};
+
+/**
+ * @brief Prepara el servidor.
+ *
+ * @param ruta Ruta del socket Unix.
+ * @param trabajadores Número de hilos que resuelven trabajos.
+ */
+ServidorSolver::ServidorSolver(const std::string& ruta, int trabajadores)
+    : ruta_(ruta), socket_(-1), despertar_{-1, -1}, activo_(false),
+      soluciones_(SOLUCIONES_EN_CACHE), directos_(DIRECTOS_EN_CACHE),
+      propagadores_(PROPAGADORES_EN_CACHE), recibidos_(0), terminados_(0),
+      grupo_(trabajadores) {}
+
+ServidorSolver::~ServidorSolver() {
+    if (socket_ >= 0) {
+        close(socket_);
+        unlink(ruta_.c_str());
+    }
+    for (int fd : despertar_) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+/**
+ * @brief Crea el socket y empieza a escuchar.
+ *
+ * @param error Descripción del error si no se pudo.
+ * @return true si el socket quedó escuchando.
+ */
+bool ServidorSolver::iniciar(std::string& error) {
+    sockaddr_un direccion;
+    std::memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    if (ruta_.size() >= sizeof(direccion.sun_path)) {
+        error = "la ruta del socket es demasiado larga";
+        return false;
+    }
+    std::strcpy(direccion.sun_path, ruta_.c_str());
+
+    if (pipe2(despertar_, O_CLOEXEC | O_NONBLOCK) != 0) {
+        error = std::string("pipe2: ") + std::strerror(errno);
+        return false;
+    }
+    socket_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket_ < 0) {
+        error = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+    unlink(ruta_.c_str());  // un socket viejo de una ejecución anterior
+    if (bind(socket_, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) != 0 ||
+        listen(socket_, 64) != 0) {
+        error = ruta_ + ": " + std::strerror(errno);
+        close(socket_);
+        socket_ = -1;
+        return false;
+    }
+    chmod(ruta_.c_str(), 0600);  // solo el usuario que lanzó el servicio
+    activo_ = true;
+    return true;
+}
+
+/**
+ * @brief Pide al bucle de atender() que termine; se puede llamar desde un manejador de señales.
+ */
+void ServidorSolver::apagar() {
+    activo_ = false;
+    if (despertar_[1] >= 0) {
+        ssize_t ignorado = write(despertar_[1], "x", 1);
+        (void)ignorado;
+    }
+}
+
+/**
+ * @brief Atiende conexiones hasta que se pida apagar el servidor.
+ */
+void ServidorSolver::atender() {
+    std::map<int, std::shared_ptr<Conexion>> conexiones;
+    std::vector<pollfd> eventos;
+    char buffer[1 << 16];
+
+    // Al apagar se deja de aceptar y de leer, pero el bucle sigue hasta entregar las
+    // respuestas de los trabajos ya encolados
+    while (activo_ || !conexiones.empty()) {
+        bool apagando = !activo_;
+        bool hayPendientes = false;
+        eventos.clear();
+        eventos.push_back(pollfd{apagando ? -1 : socket_, POLLIN, 0});
+        eventos.push_back(pollfd{despertar_[0], POLLIN, 0});
+        for (const auto& c : conexiones) {
+            short interes = (c.second->leyendo && !apagando) ? POLLIN : 0;
+            std::lock_guard<std::mutex> lock(c.second->escritura);
+            if (c.second->pendiente() > 0) {
+                interes |= POLLOUT;
+                hayPendientes = true;
+            }
+            eventos.push_back(pollfd{c.first, interes, 0});
+        }
+        // Con salida en cola se revisa cada segundo si algún cliente dejó de leer
+        if (poll(eventos.data(), eventos.size(), hayPendientes ? 1000 : -1) < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "poll: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (eventos[1].revents != 0) {
+            while (read(despertar_[0], buffer, sizeof(buffer)) > 0) {
+            }
+        }
+
+        if (eventos[0].revents & POLLIN) {
+            int fd = accept4(socket_, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+            if (fd >= 0) {
+                conexiones[fd] = std::make_shared<Conexion>(fd, despertar_[1]);
+            }
+        }
+
+        for (std::size_t k = 2; k < eventos.size(); ++k) {
+            if (eventos[k].revents == 0) continue;
+            std::shared_ptr<Conexion> conexion = conexiones.find(eventos[k].fd)->second;
+            if (eventos[k].revents & POLLOUT) {
+                std::lock_guard<std::mutex> lock(conexion->escritura);
+                conexion->vaciar();
+            }
+            if (!(eventos[k].revents & POLLIN)) {
+                if (eventos[k].revents & (POLLERR | POLLHUP)) {
+                    std::lock_guard<std::mutex> lock(conexion->escritura);
+                    conexion->descartar();
+                }
+                continue;
+            }
+
+            ssize_t leidos = read(conexion->fd, buffer, sizeof(buffer));
+            if (leidos < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+            if (leidos < 0) {
+                std::lock_guard<std::mutex> lock(conexion->escritura);
+                conexion->descartar();
+                continue;
+            }
+            if (leidos == 0) {
+                // El cliente terminó de enviar; sus trabajos en curso aún responden
+                conexion->leyendo = false;
+                continue;
+            }
+            conexion->entrada.append(buffer, static_cast<std::size_t>(leidos));
+
+            std::size_t inicio = 0, fin;
+            while ((fin = conexion->entrada.find('\n', inicio)) != std::string::npos) {
+                procesarLinea(conexion, conexion->entrada.substr(inicio, fin - inicio));
+                inicio = fin + 1;
+            }
+            conexion->entrada.erase(0, inicio);
+            if (conexion->entrada.size() > LINEA_MAXIMA) {
+                enviarError(*conexion, "null", "línea demasiado larga");
+                conexion->leyendo = false;
+                std::string().swap(conexion->entrada);
+            }
+        }
+
+        // Se cierran las conexiones que ya no tienen nada que leer ni que enviar, y las de
+        // los clientes que llevan SALIDA_ESPERA_MAXIMA sin aceptar bytes
+        Reloj::time_point ahora = Reloj::now();
+        for (auto it = conexiones.begin(); it != conexiones.end();) {
+            Conexion& c = *it->second;
+            bool cerrar;
+            {
+                std::lock_guard<std::mutex> lock(c.escritura);
+                if (c.pendiente() > 0 && ahora - c.ultimoAvance > SALIDA_ESPERA_MAXIMA) {
+                    c.descartar();
+                }
+                cerrar = c.rota || ((!c.leyendo || apagando) && c.trabajos == 0 && c.pendiente() == 0);
+            }
+            if (cerrar) {
+                shutdown(c.fd, SHUT_RDWR);  // los trabajos en curso pueden retener el descriptor
+                it = conexiones.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Interpreta un trabajo y lo encola (o lo responde en el momento si es de control).
+ */
+void ServidorSolver::procesarLinea(const std::shared_ptr<Conexion>& conexion, const std::string& linea) {
+    if (linea.find_first_not_of(" \t\r") == std::string::npos) return;
+
+    auto trabajo = std::make_shared<ValorJSON>();
+    std::string error;
+    if (!LeerJSON(linea, *trabajo, error)) {
+        enviarError(*conexion, "null", "JSON no válido: " + error);
+        return;
+    }
+    if (trabajo->tipo != ValorJSON::OBJETO) {
+        enviarError(*conexion, "null", "cada trabajo debe ser un objeto JSON");
+        return;
+    }
+    std::string id = TextoId(*trabajo);
+    std::string tipo = trabajo->textoO("tipo", "");
+
+    if (tipo == "estado") {
+        conexion->enviarLinea("{\"id\":" + id + ",\"tipo\":\"estado\"," + estado() + "}\n");
+        return;
+    }
+    if (tipo == "apagar") {
+        conexion->enviarLinea("{\"id\":" + id + ",\"tipo\":\"fin\"}\n");
+        apagar();
+        return;
+    }
+    if (tipo != "laplace" && tipo != "onda") {
+        enviarError(*conexion, id, "tipo de trabajo desconocido: '" + tipo + "'");
+        return;
+    }
+
+    int prioridad;
+    if (!LeerEntero(*trabajo, "prioridad", 0, -PRIORIDAD_MAXIMA, PRIORIDAD_MAXIMA, prioridad, error)) {
+        enviarError(*conexion, id, error);
+        return;
+    }
+    ++recibidos_;
+    ++conexion->trabajos;
+    Reloj::time_point llegada = Reloj::now();
+    grupo_.encolar(prioridad, [this, conexion, trabajo, tipo, id, llegada]() {
+        try {
+            if (tipo == "laplace") {
+                trabajoLaplace(*conexion, *trabajo, llegada);
+            } else {
+                trabajoOnda(*conexion, *trabajo, llegada);
+            }
+        } catch (const std::exception& e) {
+            enviarError(*conexion, id, e.what());
+        }
+        ++terminados_;
+        // Después de la última respuesta: poll() puede cerrar la conexión si ya no lee
+        --conexion->trabajos;
+        conexion->avisar();
+    });
+}
+
+/**
+ * @brief Resuelve la ecuación de Laplace (opciones 1 y 2 con SolucionDF, 3 con la
+ *        factorización de capacitancia guardada para ese tamaño de malla).
+ */
+void ServidorSolver::trabajoLaplace(Conexion& conexion, const ValorJSON& trabajo, Reloj::time_point llegada) {
+    std::string id = TextoId(trabajo);
+    double fronteraIzquierda = trabajo.numeroO("fronteraIzquierda", NAN);
+    double base = trabajo.numeroO("base", NAN);
+    double escalera = trabajo.numeroO("escalera", NAN);
+    double lambda = trabajo.numeroO("lambda", 1.5);
+    if (!std::isfinite(fronteraIzquierda) || !std::isfinite(base) || !std::isfinite(escalera) ||
+        !std::isfinite(lambda)) {
+        enviarError(conexion, id, "fronteraIzquierda, base y escalera son obligatorios y, con lambda, deben ser finitos");
+        return;
+    }
+    if (trabajo.miembro("nx") == nullptr || trabajo.miembro("ny") == nullptr) {
+        enviarError(conexion, id, "faltan nx o ny");
+        return;
+    }
+    // La opción se lee primero porque la solución directa admite mallas más pequeñas
+    int opcion, nx, ny;
+    std::string error;
+    if (!LeerEntero(trabajo, "opcionImplementacion", 1, 1, 3, opcion, error)) {
+        enviarError(conexion, id, error);
+        return;
+    }
+    int mallaMaxima = opcion == 3 ? MALLA_DIRECTA_MAXIMA : MALLA_MAXIMA;
+    if (!LeerEntero(trabajo, "nx", 0, 1, mallaMaxima, nx, error) ||
+        !LeerEntero(trabajo, "ny", 0, 1, mallaMaxima, ny, error)) {
+        enviarError(conexion, id, error + (opcion == 3 ? " con la opción 3" : ""));
+        return;
+    }
+    bool binario = trabajo.textoO("formato", "json") == "binario";
+
+    int codigo = VerificarDatos(fronteraIzquierda, base, escalera, nx, ny, lambda, 1.0, opcion, 1);
+    if (codigo != 0) {
+        enviarError(conexion, id, "datos no válidos (código " + std::to_string(codigo) + " de VerificarDatos)");
+        return;
+    }
+
+    std::string clave = "laplace";
+    for (double x : {fronteraIzquierda, base, escalera, opcion == 3 ? 0.0 : lambda}) AgregarClave(clave, x);
+    clave += std::to_string(nx) + "x" + std::to_string(ny) + "o" + std::to_string(opcion);
+
+    std::shared_ptr<const Resultado> resultado = soluciones_.buscar(clave);
+    bool enCache = resultado != nullptr;
+    if (!enCache) {
+        thread_local EspacioTrabajo espacio;
+        VistaMalla vista{nullptr, 0, 0, 0};
+        if (opcion == 3) {
+            auto directo = directos_.obtener(std::to_string(nx) + "x" + std::to_string(ny),
+                                             [] { return std::make_shared<DirectoEnCache>(); });
+            std::lock_guard<std::mutex> lock(directo->mutex);
+            if (!directo->solucionador) {
+                directo->solucionador.reset(new SolucionadorCapacitancia(nx, ny));
+            }
+            vista = SolucionDirecta(fronteraIzquierda, base, escalera, *directo->solucionador, espacio);
+        } else {
+            vista = SolucionDF(fronteraIzquierda, base, escalera, nx, ny, lambda, opcion, espacio);
+        }
+        auto nuevo = std::make_shared<Resultado>();
+        nuevo->filas = ny + 1;
+        nuevo->columnas = nx + 1;
+        nuevo->datos.resize(static_cast<std::size_t>(ny + 1) * (nx + 1));
+        for (int j = 0; j <= ny; ++j) {
+            std::copy(&vista(j, 0), &vista(j, 0) + nx + 1, &nuevo->datos[static_cast<std::size_t>(j) * (nx + 1)]);
+        }
+        soluciones_.guardar(clave, nuevo);
+        resultado = nuevo;
+    }
+
+    auto microsegundos = std::chrono::duration_cast<std::chrono::microseconds>(Reloj::now() - llegada).count();
+    std::string extra = std::string(",\"cache\":") + (enCache ? "true" : "false") +
+                        ",\"microsegundos\":" + std::to_string(microsegundos);
+    enviarResultado(conexion, id, "malla", *resultado, extra, binario);
+    conexion.enviarLinea("{\"id\":" + id + ",\"tipo\":\"fin\"}\n");
+}
+
+/**
+ * @brief Evalúa la cuerda en uno o varios tiempos y envía cada fotograma en cuanto está listo.
+ *
+ * Con "metodo": "espectral" (por omisión) las condiciones iniciales se proyectan una vez y el
+ * propagador queda en caché; con "fdm" se usa solve_fdm y cada fotograma queda en la caché
+ * de soluciones.
+ */
+void ServidorSolver::trabajoOnda(Conexion& conexion, const ValorJSON& trabajo, Reloj::time_point llegada) {
+    std::string id = TextoId(trabajo);
+    int n;
+    std::string error;
+    if (!LeerEntero(trabajo, "N", Nn, 2, NODOS_MAXIMO, n, error)) {
+        enviarError(conexion, id, error);
+        return;
+    }
+    double longitud = trabajo.numeroO("L", L);
+    std::string metodo = trabajo.textoO("metodo", "espectral");
+    bool binario = trabajo.textoO("formato", "json") == "binario";
+    if (!(longitud > 0.0) || !std::isfinite(longitud)) {
+        enviarError(conexion, id, "L debe ser un número finito mayor que 0");
+        return;
+    }
+    if (metodo != "espectral" && metodo != "fdm") {
+        enviarError(conexion, id, "metodo debe ser \"espectral\" o \"fdm\"");
+        return;
+    }
+
+    std::vector<double> tiempos;
+    const ValorJSON* lista = trabajo.miembro("tiempos");
+    if (lista != nullptr) {
+        if (lista->tipo != ValorJSON::LISTA || lista->lista.empty() ||
+            lista->lista.size() > TIEMPOS_MAXIMOS || !ListaNumeros(lista, lista->lista.size(), tiempos)) {
+            enviarError(conexion, id, "tiempos debe ser una lista de 1 a " + std::to_string(TIEMPOS_MAXIMOS) +
+                                      " números finitos");
+            return;
+        }
+    } else {
+        double t = trabajo.numeroO("t", NAN);
+        if (std::isnan(t)) {
+            enviarError(conexion, id, "falta t o tiempos");
+            return;
+        }
+        tiempos.push_back(t);
+    }
+    for (double t : tiempos) {
+        if (!(t >= 0.0) || !std::isfinite(t)) {
+            enviarError(conexion, id, "los tiempos deben ser finitos y no negativos");
+            return;
+        }
+        // El número de pasos del salto de rana crece con t y con N
+        if (metodo == "fdm" && !(error = errorDatosFdm(n, longitud, t)).empty()) {
+            enviarError(conexion, id, "fdm: " + error);
+            return;
+        }
+    }
+
+    const ValorJSON* desplazamiento = trabajo.miembro("y0");
+    const ValorJSON* velocidad = trabajo.miembro("v0");
+    std::vector<double> y0, v0(n + 1, 0.0);
+    if (desplazamiento != nullptr && !ListaNumeros(desplazamiento, n + 1, y0)) {
+        enviarError(conexion, id, "y0 debe ser una lista de N + 1 números");
+        return;
+    }
+    if (velocidad != nullptr && !ListaNumeros(velocidad, n + 1, v0)) {
+        enviarError(conexion, id, "v0 debe ser una lista de N + 1 números");
+        return;
+    }
+    if (metodo == "fdm" && (desplazamiento != nullptr || velocidad != nullptr)) {
+        enviarError(conexion, id, "fdm solo resuelve la condición inicial del programa");
+        return;
+    }
+
+    std::shared_ptr<PropagadorEnCache> propagador;
+    if (metodo == "espectral") {
+        std::string clave = std::to_string(n);
+        AgregarClave(clave, longitud);
+        if (desplazamiento == nullptr) {
+            y0.resize(n + 1);
+            for (int i = 0; i <= n; ++i) y0[i] = 2.0 * sin(M_PI * i * (longitud / n));
+            clave += "programa";
+        }
+        if (desplazamiento != nullptr || velocidad != nullptr) {
+            for (double x : y0) AgregarClave(clave, x);
+            for (double x : v0) AgregarClave(clave, x);
+        }
+        propagador = propagadores_.obtener(clave, [] { return std::make_shared<PropagadorEnCache>(); });
+        std::lock_guard<std::mutex> lock(propagador->mutex);
+        if (!propagador->propagador) {
+            propagador->propagador.reset(new PropagadorEspectral(n, longitud, y0, v0));
+        }
+    }
+
+    for (double t : tiempos) {
+        if (conexion.descartada()) return;  // nadie recibiría los fotogramas que faltan
+        std::shared_ptr<const Resultado> resultado;
+        bool enCache = false;
+        if (propagador) {
+            auto nuevo = std::make_shared<Resultado>();
+            nuevo->filas = 1;
+            nuevo->columnas = n + 1;
+            {
+                std::lock_guard<std::mutex> lock(propagador->mutex);
+                propagador->propagador->evaluar(t, nuevo->datos);
+            }
+            resultado = nuevo;
+        } else {
+            std::string clave = "onda" + std::to_string(n);
+            AgregarClave(clave, longitud);
+            AgregarClave(clave, t);
+            resultado = soluciones_.buscar(clave);
+            enCache = resultado != nullptr;
+            if (!enCache) {
+                thread_local EspacioTrabajo espacio;
+                const double* y = solve_fdm(n, longitud, t, espacio);
+                auto nuevo = std::make_shared<Resultado>();
+                nuevo->filas = 1;
+                nuevo->columnas = n + 1;
+                nuevo->datos.assign(y, y + n + 1);
+                soluciones_.guardar(clave, nuevo);
+                resultado = nuevo;
+            }
+        }
+
+        auto microsegundos = std::chrono::duration_cast<std::chrono::microseconds>(Reloj::now() - llegada).count();
+        std::string extra = ",\"t\":";
+        EscribirNumero(extra, t);
+        extra += std::string(",\"cache\":") + (enCache ? "true" : "false") +
+                 ",\"microsegundos\":" + std::to_string(microsegundos);
+        enviarResultado(conexion, id, "fotograma", *resultado, extra, binario);
+    }
+    conexion.enviarLinea("{\"id\":" + id + ",\"tipo\":\"fin\",\"fotogramas\":" +
+                         std::to_string(tiempos.size()) + "}\n");
+}
+
+/**
+ * @brief Contadores de trabajos y de las cachés, como miembros de un objeto JSON.
+ */
+std::string ServidorSolver::estado() {
+    std::string texto = "\"recibidos\":" + std::to_string(recibidos_.load()) +
+                        ",\"terminados\":" + std::to_string(terminados_.load()) +
+                        ",\"pendientes\":" + std::to_string(grupo_.pendientes()) +
+                        ",\"hilos\":" + std::to_string(grupo_.trabajadores());
+    auto agregar = [&texto](const char* nombre, std::size_t elementos, std::size_t aciertos, std::size_t fallos) {
+        texto += std::string(",\"") + nombre + "\":{\"elementos\":" + std::to_string(elementos) +
+                 ",\"aciertos\":" + std::to_string(aciertos) + ",\"fallos\":" + std::to_string(fallos) + "}";
+    };
+    std::size_t e, a, f;
+    soluciones_.estadisticas(e, a, f);
+    agregar("soluciones", e, a, f);
+    directos_.estadisticas(e, a, f);
+    agregar("factorizaciones", e, a, f);
+    propagadores_.estadisticas(e, a, f);
+    agregar("propagadores", e, a, f);
+    return texto;
+}
+
+/**
+ * @brief Envía un resultado: una cabecera JSON y los datos en binario, o en JSON por bloques de filas.
+ *
+ * En binario la cabecera lleva "bytes" y le siguen filas x columnas doubles en el orden de
+ * bytes de la máquina, todo con el mutex de escritura tomado para que no se intercale.
+ */
+void ServidorSolver::enviarResultado(Conexion& conexion, const std::string& id, const char* tipo,
+                                     const Resultado& resultado, const std::string& extra, bool binario) {
+    std::string cabecera = "{\"id\":" + id + ",\"tipo\":\"" + tipo + "\",\"filas\":" +
+                           std::to_string(resultado.filas) + ",\"columnas\":" +
+                           std::to_string(resultado.columnas) + extra;
+    const std::size_t columnas = static_cast<std::size_t>(resultado.columnas);
+
+    if (binario) {
+        std::size_t bytes = resultado.datos.size() * sizeof(double);
+        cabecera += ",\"bytes\":" + std::to_string(bytes) + "}\n";
+        std::lock_guard<std::mutex> lock(conexion.escritura);
+        conexion.escribir(cabecera.data(), cabecera.size());
+        conexion.escribir(reinterpret_cast<const char*>(resultado.datos.data()), bytes);
+        return;
+    }
+
+    auto agregarFila = [&](std::string& linea, int j) {
+        linea += '[';
+        for (std::size_t i = 0; i < columnas; ++i) {
+            if (i > 0) linea += ',';
+            EscribirNumero(linea, resultado.datos[j * columnas + i]);
+        }
+        linea += ']';
+    };
+
+    if (resultado.filas == 1) {
+        cabecera += ",\"datos\":";
+        agregarFila(cabecera, 0);
+        cabecera += "}\n";
+        conexion.enviarLinea(cabecera);
+        return;
+    }
+
+    // La malla sale por bloques de filas a medida que se formatean
+    conexion.enviarLinea(cabecera + "}\n");
+    for (int j0 = 0; j0 < resultado.filas; j0 += FILAS_POR_MENSAJE) {
+        int j1 = std::min(j0 + FILAS_POR_MENSAJE, resultado.filas);
+        std::string linea = "{\"id\":" + id + ",\"tipo\":\"filas\",\"inicio\":" + std::to_string(j0) + ",\"datos\":[";
+        for (int j = j0; j < j1; ++j) {
+            if (j > j0) linea += ',';
+            agregarFila(linea, j);
+        }
+        linea += "]}\n";
+        conexion.enviarLinea(linea);
+    }
+}
+
+void ServidorSolver::enviarError(Conexion& conexion, const std::string& id, const std::string& mensaje) {
+    std::string linea = "{\"id\":" + id + ",\"tipo\":\"error\",\"mensaje\":";
+    EscribirTexto(linea, mensaje);
+    linea += "}\n";
+    conexion.enviarLinea(linea);
+}
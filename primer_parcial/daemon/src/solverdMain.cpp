@@ -0,0 +1,56 @@
+/**
+ * @file     solverdMain.cpp
+ * @brief    Punto de entrada del servicio de trabajos (solverd).
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-24
+ * @version  1.0.0
+ * @license  MIT
+ */
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "servidor.h"
+
+namespace {
+
+ServidorSolver* servidorActivo = nullptr;
+
+void DetenerServidor(int) {
+    if (servidorActivo != nullptr) {
+        servidorActivo->apagar();
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Uso: solverd [ruta del socket] [hilos]
+ */
+int main(int argc, char* argv[]) {
+    std::string ruta = argc > 1 ? argv[1] : "/tmp/solverd.sock";
+    int hilos = argc > 2 ? std::atoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (hilos < 1) {
+        hilos = 1;
+    }
+
+    ServidorSolver servidor(ruta, hilos);
+    std::string error;
+    if (!servidor.iniciar(error)) {
+        std::cerr << "Error: no se pudo abrir el socket: " << error << std::endl;
+        return 1;
+    }
+
+    servidorActivo = &servidor;
+    std::signal(SIGINT, DetenerServidor);
+    std::signal(SIGTERM, DetenerServidor);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::cout << "solverd escuchando en " << ruta << " con " << hilos << " hilos" << std::endl;
+    servidor.atender();
+    servidorActivo = nullptr;
+    std::cout << "solverd: terminando los trabajos pendientes" << std::endl;
+    return 0;
+}
@@ -0,0 +1,39 @@
+"""Barrido de lambda en varios hilos con el módulo solvers, sin archivos intermedios.
+
+Uso: python scripts/barrido_lambda.py [nx] [ny]
+"""
+import os
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+import solvers
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+nx = int(sys.argv[1]) if len(sys.argv) > 1 else 100
+ny = int(sys.argv[2]) if len(sys.argv) > 2 else 100
+lambdas = [1.0, 1.25, 1.5, 1.75, 1.9]
+
+
+def resolver(lam):
+    # El GIL se libera durante SolucionDF, así que los hilos resuelven en paralelo
+    return lam, solvers.laplace_df(100.0, 50.0, 80.0, nx, ny, lambda_=lam)
+
+
+inicio = time.perf_counter()
+with ThreadPoolExecutor(max_workers=os.cpu_count()) as hilos:
+    resultados = list(hilos.map(resolver, lambdas))
+print(f"{len(lambdas)} resoluciones de {nx} x {ny} en {time.perf_counter() - inicio:.3f} s")
+
+for lam, malla in resultados:
+    if np is not None:
+        u = np.asarray(malla)  # comparte la memoria del solucionador
+        print(f"lambda = {lam:.2f}: u(3/4, 3/4) = {u[3 * ny // 4, 3 * nx // 4]:.6f}, promedio = {u.mean():.6f}")
+    else:
+        u = memoryview(malla)
+        print(f"lambda = {lam:.2f}: u(3/4, 3/4) = {u[3 * ny // 4, 3 * nx // 4]:.6f}")
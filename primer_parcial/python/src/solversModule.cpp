@@ -0,0 +1,388 @@
+/**
+ * @file     solversModule.cpp
+ * @brief    Módulo de Python que llama a los solucionadores en el mismo proceso y
+ *           devuelve los resultados sin copiarlos.
+ * @author   Isabel Nieto y Camilo Huertas
+ * @date     2025-05-22
+ * @version  1.0.0
+ * @license  MIT
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "laplaceEquation.h"
+#include "waveEquation.h"
+// Funciones de primer-corte/potencial-integrado.cpp, compilado con POTENCIAL_INTEGRADO_BIBLIOTECA
+#include "potencial-integrado.h"
+
+namespace {
+
+/**
+ * @brief Resultado de una resolución expuesto con el protocolo de buffer.
+ *
+ * El objeto es dueño de la memoria en la que escribió el solucionador (un std::vector
+ * o un espacio de trabajo) y la presta tal cual: numpy.asarray(m) o memoryview(m)
+ * ven esos mismos datos, con el paso de fila que haya dejado el solucionador.
+ */
+struct Malla {
+    PyObject_HEAD
+    std::vector<double>* vector;
+    EspacioTrabajo* espacio;
+    double* datos;
+    int ndim;
+    Py_ssize_t forma[2];
+    Py_ssize_t pasos[2];
+};
+
+PyTypeObject* TipoMalla = nullptr;
+
+void LiberarMalla(PyObject* objeto) {
+    Malla* m = reinterpret_cast<Malla*>(objeto);
+    PyTypeObject* tipo = Py_TYPE(objeto);
+    delete m->vector;
+    delete m->espacio;
+    PyObject_Free(objeto);
+    Py_DECREF(tipo);
+}
+
+int ObtenerBuffer(PyObject* objeto, Py_buffer* vista, int flags) {
+    Malla* m = reinterpret_cast<Malla*>(objeto);
+    bool contigua = m->ndim == 1 || m->pasos[0] == m->forma[1] * static_cast<Py_ssize_t>(sizeof(double));
+    if (!contigua && (flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+        PyErr_SetString(PyExc_BufferError, "la malla tiene filas con relleno: se requiere un buffer con pasos");
+        vista->obj = nullptr;
+        return -1;
+    }
+    vista->buf = m->datos;
+    vista->obj = objeto;
+    Py_INCREF(objeto);
+    vista->len = static_cast<Py_ssize_t>(sizeof(double));
+    for (int d = 0; d < m->ndim; ++d) {
+        vista->len *= m->forma[d];
+    }
+    vista->readonly = 0;
+    vista->itemsize = sizeof(double);
+    vista->format = (flags & PyBUF_FORMAT) ? const_cast<char*>("d") : nullptr;
+    vista->ndim = m->ndim;
+    vista->shape = (flags & PyBUF_ND) == PyBUF_ND ? m->forma : nullptr;
+    vista->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? m->pasos : nullptr;
+    vista->suboffsets = nullptr;
+    vista->internal = nullptr;
+    return 0;
+}
+
+PyObject* FormaMalla(PyObject* objeto, void*) {
+    Malla* m = reinterpret_cast<Malla*>(objeto);
+    return m->ndim == 1 ? Py_BuildValue("(n)", m->forma[0])
+                        : Py_BuildValue("(nn)", m->forma[0], m->forma[1]);
+}
+
+PyGetSetDef atributosMalla[] = {
+    {"forma", FormaMalla, nullptr, "Dimensiones del resultado.", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+PyType_Slot ranurasMalla[] = {
+    {Py_tp_doc, const_cast<char*>("Resultado de un solucionador; expone su memoria con el protocolo de buffer.")},
+    {Py_tp_dealloc, reinterpret_cast<void*>(LiberarMalla)},
+    {Py_tp_getset, atributosMalla},
+    {Py_bf_getbuffer, reinterpret_cast<void*>(ObtenerBuffer)},
+    {0, nullptr}
+};
+
+PyType_Spec especificacionMalla = {
+    "solvers.Malla", sizeof(Malla), 0, Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION, ranurasMalla
+};
+
+/**
+ * @brief Crea un objeto Malla que se queda con el dueño de los datos.
+ */
+PyObject* NuevaMalla(std::vector<double>* vector, EspacioTrabajo* espacio, double* datos,
+                     Py_ssize_t filas, Py_ssize_t columnas, Py_ssize_t pasoFila) {
+    Malla* m = PyObject_New(Malla, TipoMalla);
+    if (m == nullptr) {
+        delete vector;
+        delete espacio;
+        return nullptr;
+    }
+    m->vector = vector;
+    m->espacio = espacio;
+    m->datos = datos;
+    if (columnas == 0) {
+        m->ndim = 1;
+        m->forma[0] = filas;
+        m->pasos[0] = sizeof(double);
+    } else {
+        m->ndim = 2;
+        m->forma[0] = filas;
+        m->forma[1] = columnas;
+        m->pasos[0] = pasoFila * static_cast<Py_ssize_t>(sizeof(double));
+        m->pasos[1] = sizeof(double);
+    }
+    return reinterpret_cast<PyObject*>(m);
+}
+
+/**
+ * @brief Ejecuta resolver() sin el GIL para que otros hilos de Python avancen.
+ *
+ * @return false (con la excepción de Python puesta) si resolver() lanzó una excepción.
+ */
+template <typename Funcion>
+bool SinGIL(Funcion resolver) {
+    std::string error;
+    PyThreadState* estado = PyEval_SaveThread();
+    try {
+        resolver();
+    } catch (const std::exception& e) {
+        error = e.what();
+        if (error.empty()) {
+            error = "error desconocido en el solucionador";
+        }
+    }
+    PyEval_RestoreThread(estado);
+    if (!error.empty()) {
+        PyErr_SetString(PyExc_RuntimeError, error.c_str());
+        return false;
+    }
+    return true;
+}
+
+PyObject* LaplaceDF(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* claves[] = {"fronteraIzquierda", "base", "escalera", "nx", "ny",
+                                   "lambda_", "opcionImplementacion", nullptr};
+    double fronteraIzquierda, base, escalera, lambda = 1.5;
+    int nx, ny, opcionImplementacion = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "dddii|di", const_cast<char**>(claves),
+                                     &fronteraIzquierda, &base, &escalera, &nx, &ny,
+                                     &lambda, &opcionImplementacion)) {
+        return nullptr;
+    }
+    int codigo = VerificarDatos(fronteraIzquierda, base, escalera, nx, ny, lambda, 1.0,
+                                opcionImplementacion, 1);
+    if (codigo != 0) {
+        std::string mensaje = "datos no válidos (código " + std::to_string(codigo) + " de VerificarDatos)";
+        PyErr_SetString(PyExc_ValueError, mensaje.c_str());
+        return nullptr;
+    }
+
+    EspacioTrabajo* espacio = new EspacioTrabajo;
+    VistaMalla solucion{nullptr, 0, 0, 0};
+    if (!SinGIL([&] {
+            solucion = SolucionDF(fronteraIzquierda, base, escalera, nx, ny, lambda,
+                                  opcionImplementacion, *espacio);
+        })) {
+        delete espacio;
+        return nullptr;
+    }
+    return NuevaMalla(nullptr, espacio, solucion.datos, solucion.filas, solucion.columnas,
+                      static_cast<Py_ssize_t>(solucion.paso));
+}
+
+PyObject* OndaFDM(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* claves[] = {"N", "t", "L", nullptr};
+    int n;
+    double t, longitud = L;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "id|d", const_cast<char**>(claves),
+                                     &n, &t, &longitud)) {
+        return nullptr;
+    }
+    // Los mismos límites con los que solve_fdm lanzaría invalid_argument
+    std::string error = errorDatosFdm(n, longitud, t);
+    if (!error.empty()) {
+        PyErr_SetString(PyExc_ValueError, error.c_str());
+        return nullptr;
+    }
+
+    EspacioTrabajo* espacio = new EspacioTrabajo;
+    const double* y = nullptr;
+    if (!SinGIL([&] { y = solve_fdm(n, longitud, t, *espacio); })) {
+        delete espacio;
+        return nullptr;
+    }
+    return NuevaMalla(nullptr, espacio, const_cast<double*>(y), n + 1, 0, 0);
+}
+
+/**
+ * @brief Copia una secuencia de n números en un vector.
+ */
+bool LeerValores(PyObject* secuencia, Py_ssize_t n, const char* nombre, std::vector<double>& valores) {
+    std::string mensaje = std::string(nombre) + " debe ser una secuencia de N + 1 números";
+    PyObject* rapida = PySequence_Fast(secuencia, mensaje.c_str());
+    if (rapida == nullptr) {
+        return false;
+    }
+    if (PySequence_Fast_GET_SIZE(rapida) != n) {
+        PyErr_SetString(PyExc_ValueError, mensaje.c_str());
+        Py_DECREF(rapida);
+        return false;
+    }
+    valores.resize(n);
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        valores[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(rapida, i));
+        if (valores[i] == -1.0 && PyErr_Occurred()) {
+            Py_DECREF(rapida);
+            return false;
+        }
+    }
+    Py_DECREF(rapida);
+    return true;
+}
+
+PyObject* OndaEspectral(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* claves[] = {"N", "t", "L", "y0", "v0", nullptr};
+    int n;
+    double t, longitud = L;
+    PyObject* desplazamiento = Py_None;
+    PyObject* velocidad = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "id|dOO", const_cast<char**>(claves),
+                                     &n, &t, &longitud, &desplazamiento, &velocidad)) {
+        return nullptr;
+    }
+    if (n < 2 || longitud <= 0.0) {
+        PyErr_SetString(PyExc_ValueError, "se requiere N >= 2 y L > 0");
+        return nullptr;
+    }
+    std::vector<double> y0, v0(n + 1, 0.0);
+    if (desplazamiento == Py_None) {
+        for (int i = 0; i <= n; ++i) {
+            y0.push_back(2.0 * std::sin(M_PI * i * (longitud / n)));
+        }
+    } else if (!LeerValores(desplazamiento, n + 1, "y0", y0)) {
+        return nullptr;
+    }
+    if (velocidad != Py_None && !LeerValores(velocidad, n + 1, "v0", v0)) {
+        return nullptr;
+    }
+
+    std::vector<double>* y = new std::vector<double>;
+    if (!SinGIL([&] { solve_spectral(n, longitud, t, y0, v0, *y); })) {
+        delete y;
+        return nullptr;
+    }
+    return NuevaMalla(y, nullptr, y->data(), n + 1, 0, 0);
+}
+
+PyObject* PotencialAnillo(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* claves[] = {"R", "malla", "tol", nullptr};
+    double R, tol = 0.0;
+    int malla;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "di|d", const_cast<char**>(claves),
+                                     &R, &malla, &tol)) {
+        return nullptr;
+    }
+    if (R <= 0.0 || malla < 2 || tol < 0.0) {
+        PyErr_SetString(PyExc_ValueError, "se requiere R > 0, malla >= 2 y tol >= 0");
+        return nullptr;
+    }
+
+    std::vector<double>* potencial = new std::vector<double>;
+    if (!SinGIL([&] { calcularPotencial(R, *potencial, malla, tol); })) {
+        delete potencial;
+        return nullptr;
+    }
+    return NuevaMalla(potencial, nullptr, potencial->data(), malla, malla, malla);
+}
+
+/**
+ * @brief Convierte una secuencia de tuplas (x0, y0, x1, y1, lambda) en segmentos.
+ */
+bool LeerSegmentos(PyObject* secuencia, std::vector<Segmento>& segmentos) {
+    PyObject* rapida = PySequence_Fast(secuencia, "segmentos debe ser una secuencia de tuplas (x0, y0, x1, y1, lambda)");
+    if (rapida == nullptr) {
+        return false;
+    }
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(rapida);
+    segmentos.resize(n);
+    for (Py_ssize_t k = 0; k < n; ++k) {
+        Segmento& s = segmentos[k];
+        if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(rapida, k), "ddddd;cada segmento es (x0, y0, x1, y1, lambda)",
+                              &s.x0, &s.y0, &s.x1, &s.y1, &s.lambda)) {
+            Py_DECREF(rapida);
+            return false;
+        }
+    }
+    Py_DECREF(rapida);
+    return true;
+}
+
+PyObject* PotencialSegmentos(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* claves[] = {"R", "malla", "tol", "segmentos", nullptr};
+    double R, tol = 1e-6;
+    int malla;
+    PyObject* secuencia = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "di|dO", const_cast<char**>(claves),
+                                     &R, &malla, &tol, &secuencia)) {
+        return nullptr;
+    }
+    if (R <= 0.0 || malla < 2 || tol <= 0.0) {
+        PyErr_SetString(PyExc_ValueError, "se requiere R > 0, malla >= 2 y tol > 0");
+        return nullptr;
+    }
+    std::vector<Segmento> segmentos;
+    if (secuencia == Py_None) {
+        segmentos = segmentosAnillo(R, 100);
+    } else if (!LeerSegmentos(secuencia, segmentos)) {
+        return nullptr;
+    }
+    if (segmentos.empty()) {
+        PyErr_SetString(PyExc_ValueError, "no hay segmentos");
+        return nullptr;
+    }
+
+    std::vector<double>* potencial = new std::vector<double>;
+    if (!SinGIL([&] { calcularPotencialArbol(segmentos, R, *potencial, malla, tol); })) {
+        delete potencial;
+        return nullptr;
+    }
+    return NuevaMalla(potencial, nullptr, potencial->data(), malla, malla, malla);
+}
+
+PyMethodDef metodos[] = {
+    {"laplace_df", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(LaplaceDF)),
+     METH_VARARGS | METH_KEYWORDS,
+     "laplace_df(fronteraIzquierda, base, escalera, nx, ny, lambda_=1.5, opcionImplementacion=1)\n"
+     "Resuelve la ecuación de Laplace con SolucionDF; devuelve una Malla (ny + 1) x (nx + 1)."},
+    {"onda_fdm", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(OndaFDM)),
+     METH_VARARGS | METH_KEYWORDS,
+     "onda_fdm(N, t, L=4.0)\n"
+     "Resuelve la ecuación de onda con solve_fdm hasta el tiempo t; devuelve una Malla de N + 1 puntos."},
+    {"onda_espectral", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(OndaEspectral)),
+     METH_VARARGS | METH_KEYWORDS,
+     "onda_espectral(N, t, L=4.0, y0=None, v0=None)\n"
+     "Propagador espectral exacto en el tiempo (solve_spectral); y0 y v0 son secuencias de N + 1 valores\n"
+     "(por omisión el problema del programa). Devuelve una Malla de N + 1 puntos."},
+    {"potencial_anillo", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(PotencialAnillo)),
+     METH_VARARGS | METH_KEYWORDS,
+     "potencial_anillo(R, malla, tol=0.0)\n"
+     "Potencial del anillo con calcularPotencial (tol = 0: trapecio fijo); Malla malla x malla indexada [x, y]."},
+    {"potencial_segmentos", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(PotencialSegmentos)),
+     METH_VARARGS | METH_KEYWORDS,
+     "potencial_segmentos(R, malla, tol=1e-6, segmentos=None)\n"
+     "Potencial de segmentos (x0, y0, x1, y1, lambda) con el árbol multipolar; None usa el anillo."},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyModuleDef modulo = {
+    PyModuleDef_HEAD_INIT, "solvers",
+    "Solucionadores de primer_parcial y primer-corte con resultados compartidos sin copia.",
+    -1, metodos, nullptr, nullptr, nullptr, nullptr
+};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_solvers(void) {
+    PyObject* m = PyModule_Create(&modulo);
+    if (m == nullptr) {
+        return nullptr;
+    }
+    TipoMalla = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&especificacionMalla));
+    if (TipoMalla == nullptr || PyModule_AddObjectRef(m, "Malla", reinterpret_cast<PyObject*>(TipoMalla)) < 0) {
+        Py_DECREF(m);
+        return nullptr;
+    }
+    return m;
+}
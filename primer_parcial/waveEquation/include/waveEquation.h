@@ -19,11 +19,33 @@
 #include <cstdlib>
 #include <iomanip> // ✅ para setw y setprecision
 #include <limits> // ⬅️ Agregar esta línea si no está
+#include <chrono>
+#include <thread>
+#include "espacioTrabajo.h"
+#include "transformadas.h"
 
 using namespace std;
 double solicitarTiempo();
 double analytic(double x, double t);
 void solve_fdm(int N, double L, double t_target, vector<double>& y_num);
+void solve_fdm(int N, double L, double t_target, vector<double>& y_num, EspacioTrabajo& espacio);
+const double* solve_fdm(int N, double L, double t_target, EspacioTrabajo& espacio);
+void solve_spectral(int N, double L, double t_target, vector<double>& y_num);
+void solve_spectral(int N, double L, double t_target, const vector<double>& y0,
+                    const vector<double>& v0, vector<double>& y_num);
+
+// Resultado de solve_parareal: iteraciones hechas, mayor corrección de la última iteración en
+// las fronteras de las rebanadas y si bajó de la tolerancia (o se hicieron todas)
+struct InformeParareal {
+    int iteraciones;
+    double correccion;
+    bool convergio;
+};
+// solve_fdm en paralelo en el tiempo: 'rebanadas' hilos con el salto de rana fino y un
+// propagador grueso espectral que cruza cada rebanada en un solo paso
+InformeParareal solve_parareal(int N, double L, double t_target, int rebanadas, vector<double>& y_num,
+                               double tolerancia = 1e-8);
+void compararParareal(int N, double L, double t_target, int maxRebanadas);
 void guardarDatos(double t, const vector<double>& y_num);
 void graficarDatos();
 int contarLineas(const string& file);
@@ -32,11 +54,33 @@ void guardarDatosgifN(int Nt);
 void generarGif2DN(const string& dataFile, const string& gifName, const string& scriptName, double t_max);
 void generarGif2DA(const string& dataFile, const string& gifName, const string& scriptName, double t_max);
 
+// Propagador exacto en el tiempo del sistema semidiscreto y_i'' = c^2 (y_{i+1} - 2 y_i + y_{i-1}) / dx^2:
+// cada modo sin(k pi i / N) oscila con omega_k = 2 c / dx sin(k pi / (2N)), así que evaluar
+// en cualquier t cuesta una DST, O(N log N), sin paso de tiempo ni condición CFL.
+class PropagadorEspectral {
+public:
+    // y0 y v0: desplazamiento y velocidad iniciales en los N + 1 nodos (los extremos se ignoran);
+    // lanza invalid_argument si no tienen N + 1 valores
+    PropagadorEspectral(int N, double L, const vector<double>& y0, const vector<double>& v0);
+    void evaluar(double t, vector<double>& y);
+private:
+    int N_;
+    PlanDST dst_;
+    vector<double> amplitudCos_, amplitudSen_, omega_;
+};
+
 const double c = 3.0;         // velocidad de la onda (c = 3)
 const double L = 4.0;         // longitud del dominio en x
 const int Na = 100;           // malla analítica
 const int Nn = 10;           // malla numérica
 const double t_max = 5.0;     // tiempo máximo fijo para animación
+const int NODOS_MAXIMO = 1 << 20;        // N máximo de solve_fdm y del propagador espectral
+const double TRABAJO_FDM_MAXIMO = 4e9;   // nodos x pasos de una llamada a solve_fdm
+
+// Motivo por el que solve_fdm rechazaría N, L o t_target ("" si son válidos): N entre 2 y
+// NODOS_MAXIMO, L > 0 y t_target >= 0 finitos, y N x pasos hasta t_target sin pasar de
+// TRABAJO_FDM_MAXIMO. solve_fdm y solve_parareal lanzan invalid_argument con este texto.
+string errorDatosFdm(int N, double L, double t_target);
 
 
 #endif // WAVEEQUATION_H
\ No newline at end of file
@@ -7,6 +7,12 @@
  * @license  MIT
  */
 #include "../include/waveEquation.h"
+#include "pipelineSalida.h"
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
 
 // Lee tiempo desde consola
 double solicitarTiempo() {
@@ -41,13 +47,76 @@ double analytic(double x, double t) {
 
 // Esquema explícito de diferencias finitas
 void solve_fdm(int N, double L, double t_target, vector<double>& y_num) {
-    double dx = L / N;
-    double dt = dx / c * 0.9;                 // CFL: r = c*dt/dx = 0.9
-    int steps = static_cast<int>(t_target / dt);
+    EspacioTrabajo espacio;
+    solve_fdm(N, L, t_target, y_num, espacio);
+}
+
+// Igual que solve_fdm, con los tres niveles de tiempo en un espacio de trabajo
+// que el llamador conserva: no reserva memoria en llamadas repetidas
+void solve_fdm(int N, double L, double t_target, vector<double>& y_num, EspacioTrabajo& espacio) {
+    const double* y = solve_fdm(N, L, t_target, espacio);
+    y_num.assign(y, y + N+1);
+}
+
+// Pasos hasta t_target con el paso de CFL r = c*dt/dx = 0.9, sin convertir todavía a int
+static double pasosCfl(int N, double L, double t_target) {
+    return t_target / (L / N / c * 0.9);
+}
+
+string errorDatosFdm(int N, double L, double t_target) {
+    if (N < 2 || N > NODOS_MAXIMO) {
+        return "N debe estar entre 2 y " + to_string(NODOS_MAXIMO);
+    }
+    if (!(L > 0.0) || !isfinite(L)) {
+        return "L debe ser un número finito mayor que 0";
+    }
+    if (!(t_target >= 0.0) || !isfinite(t_target)) {
+        return "t debe ser un número finito no negativo";
+    }
+    if (static_cast<double>(N) * pasosCfl(N, L, t_target) > TRABAJO_FDM_MAXIMO) {
+        return "N x pasos del salto de rana supera el límite; use el propagador espectral o un t menor";
+    }
+    return "";
+}
+
+// Paso de tiempo del esquema: CFL r = c*dt/dx = 0.9, ajustado para llegar justo a t_target
+// (al menos un paso, para que dt no quede en t/0 con t muy pequeño)
+static int pasosFdm(int N, double L, double t_target, double& dt) {
+    string error = errorDatosFdm(N, L, t_target);
+    if (!error.empty()) {
+        throw invalid_argument(error);
+    }
+    int steps = max(1, static_cast<int>(pasosCfl(N, L, t_target)));
     dt = t_target / steps;
+    return steps;
+}
+
+// Avanza el salto de rana 'pasos' pasos; al terminar y_prev e y_curr apuntan a los dos
+// últimos niveles (los tres buffers se rotan en lugar de copiarse)
+static void avanzarSalto(int N, double r2, int pasos, double*& y_prev, double*& y_curr, double*& y_next) {
+    for (int n = 1; n <= pasos; ++n) {
+        for (int i = 1; i < N; ++i) {
+            y_next[i] = 2*y_curr[i] - y_prev[i]
+                      + r2*(y_curr[i+1] - 2*y_curr[i] + y_curr[i-1]);
+        }
+        y_next[0] = y_next[N] = 0.0;
+        double* libre = y_prev;
+        y_prev = y_curr;
+        y_curr = y_next;
+        y_next = libre;
+    }
+}
 
-    y_num.assign(N+1, 0.0);
-    vector<double> y_prev(N+1), y_curr(N+1), y_next(N+1);
+// Deja la solución en una de las ranuras del espacio y devuelve el puntero,
+// sin copiarla; es válido hasta la siguiente resolución con el mismo espacio
+const double* solve_fdm(int N, double L, double t_target, EspacioTrabajo& espacio) {
+    double dx = L / N;
+    double dt;
+    int steps = pasosFdm(N, L, t_target, dt);
+
+    double* y_prev = espacio.buffer(0, N+1);
+    double* y_curr = espacio.buffer(1, N+1);
+    double* y_next = espacio.buffer(2, N+1);
 
     // Condición inicial y_t(x,0)=0, y(x,0)=2 sin(pi x)
     for (int i = 0; i <= N; ++i) {
@@ -59,16 +128,218 @@ void solve_fdm(int N, double L, double t_target, vector<double>& y_num) {
     y_curr[0] = y_curr[N] = 0.0;
 
     double r2 = pow(c*dt/dx, 2);
-    for (int n = 1; n <= steps; ++n) {
-        for (int i = 1; i < N; ++i) {
-            y_next[i] = 2*y_curr[i] - y_prev[i]
-                      + r2*(y_curr[i+1] - 2*y_curr[i] + y_curr[i-1]);
+    avanzarSalto(N, r2, steps, y_prev, y_curr, y_next);
+    return y_curr;
+}
+
+// Propagador grueso espectral: cada modo del sistema semidiscreto avanza de forma exacta
+// (como en PropagadorEspectral) toda la rebanada en un solo paso. Del par (y^{n-1}, y^n) se
+// toman Y_k(0) = Y_k^n e Y_k(-dt) = Y_k^{n-1}, y se devuelve el par (Y(T - dt), Y(T)).
+static void propagarModos(PlanDST& dst, const vector<double>& omega, int N, double dt, double T,
+                          const double* entrada, double* salida) {
+    if (N < 2) {
+        fill(salida, salida + 2*(N+1), 0.0);
+        return;
+    }
+    vector<double> a(entrada + N+2, entrada + 2*N+1), b(entrada + 1, entrada + N);
+    dst.transformar(a.data(), b.data());
+    for (int k = 0; k < N-1; ++k) {
+        double w = omega[k];
+        double amplitudCos = a[k] * (2.0 / N);
+        double amplitudSen = (amplitudCos * cos(w * dt) - b[k] * (2.0 / N)) / sin(w * dt);
+        b[k] = amplitudCos * cos(w * (T - dt)) + amplitudSen * sin(w * (T - dt));
+        a[k] = amplitudCos * cos(w * T) + amplitudSen * sin(w * T);
+    }
+    dst.transformar(b.data(), a.data());
+    salida[0] = salida[N] = salida[N+1] = salida[2*N+1] = 0.0;
+    copy(b.begin(), b.end(), salida + 1);
+    copy(a.begin(), a.end(), salida + N+2);
+}
+
+// Parareal sobre el mismo salto de rana de solve_fdm: los pasos se reparten en rebanadas de
+// tiempo, el propagador grueso recorre las rebanadas en serie y el fino (el salto de rana)
+// corre en paralelo, repartido entre tantos hilos como núcleos haya; cada iteración corrige U_{p+1} = G(U_p) + F(U_p^ant) -
+// G(U_p^ant). Tras k iteraciones las primeras k rebanadas ya coinciden con el resultado en serie,
+// así que con 'rebanadas' iteraciones el resultado es exactamente el de solve_fdm.
+InformeParareal solve_parareal(int N, double L, double t_target, int rebanadas, vector<double>& y_num,
+                               double tolerancia) {
+    double dx = L / N;
+    double dt;
+    int steps = pasosFdm(N, L, t_target, dt);
+    double r2 = pow(c*dt/dx, 2);
+    int P = max(1, min(rebanadas, steps));
+    const size_t tam = 2 * (N+1);
+
+    // Estados en las fronteras de las rebanadas: U[p] = par de niveles al inicio de la rebanada p
+    vector<vector<double>> U(P+1, vector<double>(tam)), gruesoViejo(P, vector<double>(tam)),
+                           fino(P, vector<double>(tam));
+    vector<int> pasos(P);
+    for (int p = 0; p < P; ++p) {
+        pasos[p] = steps / P + (p < steps % P ? 1 : 0);
+    }
+    for (int i = 0; i <= N; ++i) {
+        double x = i * dx;
+        U[0][i] = U[0][N+1 + i] = (i == 0 || i == N) ? 0.0 : 2.0 * sin(M_PI * x);
+    }
+
+    // Frecuencias de los modos del sistema semidiscreto, como en PropagadorEspectral
+    PlanDST dst(max(1, N-1));
+    vector<double> omega(max(1, N-1));
+    for (int k = 1; k < N; ++k) {
+        omega[k-1] = 2.0 * c / dx * sin(k * M_PI / (2.0 * N));
+    }
+    auto grueso = [&](int p, const vector<double>& entrada, vector<double>& salida) {
+        propagarModos(dst, omega, N, dt, pasos[p] * dt, entrada.data(), salida.data());
+    };
+
+    // Iteración 0: solo el propagador grueso
+    for (int p = 0; p < P; ++p) {
+        grueso(p, U[p], gruesoViejo[p]);
+        U[p+1] = gruesoViejo[p];
+    }
+
+    // Los mismos hilos (y los tres niveles de cada rebanada) sirven para todas las iteraciones;
+    // la cola admite todas las rebanadas, así que encolar no bloquea. Cada rebanada va en un
+    // packaged_task: PipelineSalida solo registra las excepciones, y aquí deben llegar al llamador
+    int nucleos = max(1, static_cast<int>(thread::hardware_concurrency()));
+    PipelineSalida trabajadores(P, min(P, nucleos));
+    vector<vector<double>> niveles(P, vector<double>(3 * (N+1)));
+
+    InformeParareal informe{0, 0.0, false};
+    vector<double> gruesoNuevo(tam);
+    for (int k = 1; k <= P && !informe.convergio; ++k) {
+        // Propagador fino en paralelo sobre las rebanadas que aún no convergieron
+        vector<future<void>> finos;
+        for (int p = k-1; p < P; ++p) {
+            auto fino_p = make_shared<packaged_task<void()>>([&, p]() {
+                copy(U[p].begin(), U[p].end(), niveles[p].begin());
+                double* y_prev = niveles[p].data();
+                double* y_curr = y_prev + N+1;
+                double* y_next = y_curr + N+1;
+                avanzarSalto(N, r2, pasos[p], y_prev, y_curr, y_next);
+                copy(y_prev, y_prev + N+1, fino[p].begin());
+                copy(y_curr, y_curr + N+1, fino[p].begin() + N+1);
+            });
+            finos.push_back(fino_p->get_future());
+            trabajadores.encolar([fino_p]() { (*fino_p)(); });
         }
-        y_next[0] = y_next[N] = 0.0;
-        y_prev = y_curr;
-        y_curr = y_next;
+        // Se espera a todas las rebanadas antes de relanzar, porque usan los vectores de esta función
+        exception_ptr fallo;
+        for (auto& f : finos) {
+            try {
+                f.get();
+            } catch (...) {
+                if (!fallo) fallo = current_exception();
+            }
+        }
+        if (fallo) {
+            rethrow_exception(fallo);
+        }
+
+        // Corrección en serie; la rebanada k-1 parte de un estado ya exacto y queda igual a F
+        informe.correccion = 0.0;
+        for (int p = k-1; p < P; ++p) {
+            bool exacta = p == k-1;
+            if (!exacta) {
+                grueso(p, U[p], gruesoNuevo);
+            }
+            for (size_t i = 0; i < tam; ++i) {
+                double corregido = exacta ? fino[p][i] : gruesoNuevo[i] + fino[p][i] - gruesoViejo[p][i];
+                informe.correccion = max(informe.correccion, fabs(corregido - U[p+1][i]));
+                U[p+1][i] = corregido;
+            }
+            if (!exacta) {
+                swap(gruesoViejo[p], gruesoNuevo);
+            }
+        }
+        informe.iteraciones = k;
+        informe.convergio = informe.correccion <= tolerancia || k == P;
     }
-    y_num = y_curr;
+
+    y_num.assign(U[P].begin() + N+1, U[P].end());
+    return informe;
+}
+
+// Tabla de Parareal frente a solve_fdm en una malla fina: iteraciones, diferencia con el
+// resultado en serie, tiempo y aceleración para 1, 2, 4, ... rebanadas. La cota P/K es la
+// aceleración con un núcleo por rebanada si el propagador grueso no costara nada.
+void compararParareal(int N, double L, double t_target, int maxRebanadas) {
+    using Reloj = chrono::steady_clock;
+    vector<double> serie, paralelo;
+    auto inicio = Reloj::now();
+    solve_fdm(N, L, t_target, serie);
+    double tiempoSerie = chrono::duration<double>(Reloj::now() - inicio).count();
+
+    cout << " >> Parareal, N = " << N << ", t = " << t_target << " ("
+         << thread::hardware_concurrency() << " núcleos disponibles)" << endl;
+    cout << "    serie: " << fixed << setprecision(4) << tiempoSerie << " s" << endl;
+    cout << "    rebanadas  iteraciones  dif. con serie    tiempo (s)  aceleración  cota P/K" << endl;
+    for (int P = 1; P <= maxRebanadas; P *= 2) {
+        inicio = Reloj::now();
+        InformeParareal informe = solve_parareal(N, L, t_target, P, paralelo);
+        double tiempo = chrono::duration<double>(Reloj::now() - inicio).count();
+        double diferencia = 0.0;
+        for (int i = 0; i <= N; ++i) {
+            diferencia = max(diferencia, fabs(paralelo[i] - serie[i]));
+        }
+        cout << "    " << setw(9) << P << setw(13) << informe.iteraciones
+             << setw(16) << scientific << setprecision(2) << diferencia
+             << setw(14) << fixed << setprecision(4) << tiempo
+             << setw(13) << setprecision(2) << tiempoSerie / tiempo
+             << setw(10) << static_cast<double>(P) / informe.iteraciones
+             << (informe.convergio ? "" : "  (sin converger)") << endl;
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Proyecta las condiciones iniciales en los modos: Y_k(t) = A_k cos(w_k t) + B_k sin(w_k t),
+// con A_k y B_k ya multiplicados por el factor 2/N de la DST inversa
+PropagadorEspectral::PropagadorEspectral(int N, double L, const vector<double>& y0, const vector<double>& v0)
+    : N_(N), dst_(max(1, N-1)), amplitudCos_(max(1, N-1)), amplitudSen_(max(1, N-1)), omega_(max(1, N-1)) {
+    // La DST lee los N - 1 nodos interiores de y0 y v0
+    if (N < 0 || y0.size() != static_cast<size_t>(N) + 1 || v0.size() != static_cast<size_t>(N) + 1) {
+        throw invalid_argument("y0 y v0 deben tener N + 1 = " + to_string(static_cast<long long>(N) + 1) + " valores");
+    }
+    if (N < 2) return;
+    double dx = L / N;
+    for (int i = 1; i < N; ++i) {
+        amplitudCos_[i-1] = y0[i];
+        amplitudSen_[i-1] = v0[i];
+    }
+    dst_.transformar(amplitudCos_.data(), amplitudSen_.data());
+    for (int k = 1; k < N; ++k) {
+        omega_[k-1] = 2.0 * c / dx * sin(k * M_PI / (2.0 * N));
+        amplitudCos_[k-1] *= 2.0 / N;
+        amplitudSen_[k-1] *= 2.0 / (N * omega_[k-1]);
+    }
+}
+
+// Avanza cada modo analíticamente hasta t y vuelve a los nodos con una DST
+void PropagadorEspectral::evaluar(double t, vector<double>& y) {
+    y.assign(N_+1, 0.0);
+    if (N_ < 2) return;
+    for (int k = 0; k < N_-1; ++k) {
+        y[k+1] = amplitudCos_[k] * cos(omega_[k] * t) + amplitudSen_[k] * sin(omega_[k] * t);
+    }
+    dst_.transformar(&y[1]);
+}
+
+// Alternativa espectral a solve_fdm para el problema del programa: y(x,0)=2 sin(pi x), y_t(x,0)=0
+void solve_spectral(int N, double L, double t_target, vector<double>& y_num) {
+    vector<double> y0(N+1), v0(N+1, 0.0);
+    for (int i = 0; i <= N; ++i) {
+        y0[i] = 2.0 * sin(M_PI * i * (L / N));
+    }
+    solve_spectral(N, L, t_target, y0, v0, y_num);
+}
+
+// Desplazamiento y velocidad iniciales arbitrarios (N + 1 nodos, extremos fijos en cero);
+// PropagadorEspectral lanza invalid_argument si y0 o v0 tienen otro tamaño
+void solve_spectral(int N, double L, double t_target, const vector<double>& y0,
+                    const vector<double>& v0, vector<double>& y_num) {
+    PropagadorEspectral propagador(N, L, y0, v0);
+    propagador.evaluar(t_target, y_num);
 }
 
 // Escribe dataA.dat y dataN.dat
@@ -119,17 +390,41 @@ void guardarDatosgifA(int Nt) {
     }
     out.close();
 }
+// Cada fotograma se copia a uno de los buffers fijos y un hilo de fondo lo formatea
+// directamente sobre el archivo mientras se calcula el siguiente; el ciclo no arma
+// cadenas ni reserva memoria por fotograma
+struct SalidaFotogramas {
+    ofstream& out;
+    BuffersSalida& buffers;
+    vector<double>& tiempos;
+};
+
 void guardarDatosgifN(int Nt) {
+    const size_t colaEscritura = 8;
     ofstream out("onda_animN.dat");
-    vector<double> y_num;
+    BuffersSalida fotogramas(colaEscritura + 2);
+    vector<double> tiempos(colaEscritura + 2);
+    SalidaFotogramas salida{out, fotogramas, tiempos};
+    PipelineSalida escritura(colaEscritura);
+    EspacioTrabajo espacio;
     for (int j = 0; j <= Nt; ++j) {
         double t = t_max * j / Nt;
-        solve_fdm(Nn, L, t, y_num);
-        for (int i = 0; i <= Nn; ++i) {
-            double x = L * i / Nn;
-            out << t << "\t" << x << "\t" << y_num[i] << "\n";
-        }
+        const double* y = solve_fdm(Nn, L, t, espacio);
+        size_t ranura = fotogramas.tomar(Nn + 1);
+        copy(y, y + Nn + 1, fotogramas.datos(ranura));
+        tiempos[ranura] = t;
+        // La captura (una referencia y un índice) cabe en std::function sin reservar memoria
+        escritura.encolar([&salida, ranura]() {
+            const double* fotograma = salida.buffers.datos(ranura);
+            double tf = salida.tiempos[ranura];
+            for (int i = 0; i <= Nn; ++i) {
+                double x = L * i / Nn;
+                salida.out << tf << "\t" << x << "\t" << fotograma[i] << "\n";
+            }
+            salida.buffers.liberar(ranura);
+        });
     }
+    escritura.esperar();
     out.close();
 }
 void generarGif2DA(const string& dataFile, const string& gifName, const string& scriptName, double t_max) {
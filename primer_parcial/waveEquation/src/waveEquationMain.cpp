@@ -1,14 +1,57 @@
 #include "../include/waveEquation.h"
+#include "pipelineSalida.h"
+
+// Uso: ./waveEquation [--parareal [N t]]
+// Con --parareal solo se compara Parareal con el salto de rana en serie, por omisión con
+// N = 4000 hasta t = 50 (unos segundos en serie: el caso largo para el que sirve Parareal).
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        string uso = string("Uso: ") + argv[0] + " [--parareal [N t]]";
+        if (string(argv[1]) != "--parareal" || (argc != 2 && argc != 4)) {
+            cerr << uso << endl;
+            return 1;
+        }
+        int N = argc == 4 ? atoi(argv[2]) : 4000;
+        double tFinal = argc == 4 ? atof(argv[3]) : 50.0;
+        string error = errorDatosFdm(N, L, tFinal);
+        if (!error.empty()) {
+            cerr << error << endl << uso << endl;
+            return 1;
+        }
+        compararParareal(N, L, tFinal, 16);
+        return 0;
+    }
 
-int main() {
     //tiempo máximo fijo para animación
     // 1) Solicitar tiempo
     double t = solicitarTiempo();
+    string error = errorDatosFdm(Nn, L, t);
+    if (!error.empty()) {
+        cerr << "Tiempo no válido: " << error << endl;
+        return 1;
+    }
 
     // 2) Resolver numéricamente
     vector<double> y_num;
     solve_fdm(Nn, L, t, y_num);
 
+    // Misma malla con el propagador espectral (sin error de paso de tiempo)
+    vector<double> y_esp;
+    solve_spectral(Nn, L, t, y_esp);
+    // Ambos se comparan con la solución analítica; la diferencia FDM - espectral
+    // aísla el error del paso de tiempo, porque los dos comparten la malla en x
+    double errorFdm = 0.0, errorEsp = 0.0, diferencia = 0.0;
+    for (int i = 0; i <= Nn; ++i) {
+        double y_ana = analytic(L * i / Nn, t);
+        errorFdm = max(errorFdm, fabs(y_num[i] - y_ana));
+        errorEsp = max(errorEsp, fabs(y_esp[i] - y_ana));
+        diferencia = max(diferencia, fabs(y_num[i] - y_esp[i]));
+    }
+    cout << " >> Error máximo frente a la analítica: FDM = " << errorFdm
+         << ", espectral = " << errorEsp << endl;
+    cout << " >> Diferencia máxima FDM - espectral (error del paso de tiempo): "
+         << diferencia << endl;
+
     // 3) Guardar datos en archivos
     guardarDatos(t, y_num);
 
@@ -17,14 +60,23 @@ int main() {
     
     int Nt = 50; // número de fotogramas
 
+    // La animación analítica (datos + GIF) corre en segundo plano mientras
+    // se calculan los fotogramas numéricos
+    PipelineSalida animaciones(2, 2);
+    animaciones.encolar([Nt]() {
+        guardarDatosgifA(Nt);
+        generarGif2DA("onda_anim.dat", "onda_evolucion.gif", "animacion2D.gnu", t_max);
+    });
+
     // Generar archivo con todos los tiempos
-    guardarDatosgifA(Nt);
     guardarDatosgifN(Nt);
 
     // Crear GIF animado 2D
-    generarGif2DA("onda_anim.dat", "onda_evolucion.gif", "animacion2D.gnu", t_max);
-    generarGif2DN("onda_animN.dat", "onda_evolucionN.gif", "animacion2DN.gnu", t_max);
-    
+    animaciones.encolar([]() {
+        generarGif2DN("onda_animN.dat", "onda_evolucionN.gif", "animacion2DN.gnu", t_max);
+    });
+    animaciones.esperar();
+
 
     return 0;
 }